@@ -0,0 +1,278 @@
+/******************************************************************************
+ * bench.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment 
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz 
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <argtable2.h>
+#include <fstream>
+#include <iostream>
+#include <math.h>
+#include <regex.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h> 
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/normal_matrix.h"
+#include "data_structure/matrix/online_distance_matrix.h"
+#include "macros_assertions.h"
+#include "parse_parameters.h"
+#include "partition/partition_config.h"
+#include "mapping/communication_graph_search_space.h"
+#include "mapping/construct_distance_matrix.h"
+#include "mapping/construct_mapping.h"
+#include "mapping/full_search_space.h"
+#include "mapping/full_search_space_pruned.h"
+#include "mapping/local_search_mapping.h"
+#include "null_buffer.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "synthetic_models.h"
+#include "timer.h"
+
+// above this number of PEs the distance matrix is not stored explicitly
+#define BENCH_MAX_STORED_DISTANCE_MATRIX 16384
+
+// local search is bounded by this time (in s) if no time limit is given
+#define BENCH_DEFAULT_TIME_LIMIT 60
+
+struct bench_hierarchy {
+        std::vector< int > group_sizes;
+        std::vector< int > distances;
+};
+
+static std::vector< std::string > split( const std::string & list ) {
+        std::vector< std::string > items;
+        std::istringstream f(list);
+        std::string s;
+        while (getline(f, s, ',')) {
+                if( s != "" ) items.push_back(s);
+        }
+        return items;
+}
+
+static std::string join( const std::vector< int > & values ) {
+        std::stringstream ss;
+        for( unsigned i = 0; i < values.size(); i++) {
+                if( i > 0 ) ss << ":";
+                ss << values[i];
+        }
+        return ss.str();
+}
+
+// resets the peak resident set size of the process (linux only)
+static void reset_peak_rss() {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        if( clear_refs ) clear_refs << "5";
+}
+
+// peak resident set size in kB since the last reset
+static long peak_rss() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while( std::getline(status, line) ) {
+                if( line.compare(0, 6, "VmHWM:") == 0 ) {
+                        return atol(line.c_str() + 6);
+                }
+        }
+        return -1;
+}
+
+// three system shapes with k PEs: cores/sockets/nodes, a binary tree and a flat two level system
+static void build_hierarchies( int k, std::vector< bench_hierarchy > & hierarchies) {
+        bench_hierarchy h;
+        h.group_sizes = {4, 16, k/64};
+        h.distances   = {1, 10, 100};
+        hierarchies.push_back(h);
+
+        h.group_sizes.clear();
+        h.distances.clear();
+        for( int size = 1, distance = 1; size < k; size *= 2, distance *= 2) {
+                h.group_sizes.push_back(2);
+                h.distances.push_back(distance);
+        }
+        hierarchies.push_back(h);
+
+        h.group_sizes = {64, k/64};
+        h.distances   = {1, 100};
+        hierarchies.push_back(h);
+}
+
+static bool set_construction_algorithm( PartitionConfig & config, std::string name ) {
+        if( name == "random" )                 config.construction_algorithm = MAP_CONST_RANDOM;
+        else if( name == "identity" )          config.construction_algorithm = MAP_CONST_IDENTITY;
+        else if( name == "growing" )           config.construction_algorithm = MAP_CONST_OLDGROWING_FASTER;
+        else if( name == "hierarchybottomup" ) config.construction_algorithm = MAP_CONST_FASTHIERARCHY_BOTTOMUP;
+        else if( name == "hierarchytopdown" )  config.construction_algorithm = MAP_CONST_FASTHIERARCHY_TOPDOWN;
+        else return false;
+        return true;
+}
+
+static bool set_neighborhood( PartitionConfig & config, std::string name ) {
+        if( name == "nsquare" )            config.ls_neighborhood = NSQUARE;
+        else if( name == "nsquarepruned" ) config.ls_neighborhood = NSQUAREPRUNED;
+        else if( name == "communication" ) config.ls_neighborhood = COMMUNICATIONGRAPH;
+        else return false;
+        return true;
+}
+
+static bool run_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank,
+                              local_search_mapping & lsm) {
+        switch( config.ls_neighborhood ) {
+                case NSQUARE:
+                        return lsm.perform_local_search< full_search_space > ( config, C, D, perm_rank);
+                case NSQUAREPRUNED:
+                        return lsm.perform_local_search< full_search_space_pruned > ( config, C, D, perm_rank);
+                case COMMUNICATIONGRAPH:
+                        return lsm.perform_local_search< communication_graph_search_space > ( config, C, D, perm_rank);
+        }
+        return true;
+}
+
+// runs every combination of synthetic model, system hierarchy, construction algorithm and 
+// local search neighborhood for k PEs and writes one csv line per run to FILE
+int main(int argn, char **argv) {
+
+        PartitionConfig config;
+        std::string csv_filename;
+
+        bool is_graph_weighted = false;
+        bool suppress_output   = false;
+        bool recursive         = false;
+
+        int ret_code = parse_parameters(argn, argv, 
+                        config, 
+                        csv_filename, 
+                        is_graph_weighted, 
+                        suppress_output, recursive); 
+
+        if(ret_code) {
+                return 0;
+        }
+
+        int k = config.k;
+        if( k < 64 || (k & (k-1)) != 0 ) {
+                std::cout <<  "k has to be a power of two and at least 64."  << std::endl;
+                exit(0);
+        }
+        if( config.time_limit <= 0 ) config.time_limit = BENCH_DEFAULT_TIME_LIMIT;
+
+        std::vector< std::string > models        = split( config.bench_models );
+        std::vector< std::string > constructions = split( config.bench_construction_algorithms );
+        std::vector< std::string > neighborhoods = split( config.bench_neighborhoods );
+        PartitionConfig check = config;
+        for( unsigned i = 0; i < constructions.size(); i++) {
+                if( !set_construction_algorithm( check, constructions[i] ) ) {
+                        std::cout <<  "unknown construction algorithm " <<  constructions[i]  << std::endl;
+                        exit(0);
+                }
+        }
+        for( unsigned i = 0; i < neighborhoods.size(); i++) {
+                if( !set_neighborhood( check, neighborhoods[i] ) ) {
+                        std::cout <<  "unknown neighborhood " <<  neighborhoods[i]  << std::endl;
+                        exit(0);
+                }
+        }
+
+        std::vector< bench_hierarchy > hierarchies;
+        build_hierarchies( k, hierarchies );
+
+        std::ofstream csv(csv_filename.c_str());
+        if( !csv ) {
+                std::cout <<  "could not open " <<  csv_filename  << std::endl;
+                exit(0);
+        }
+        csv << "model,n,m,hierarchy,distances,construction,neighborhood,construction_time,local_search_time,"
+            << "swaps_evaluated,swaps_performed,initial_objective,objective,peak_rss_kb" << std::endl;
+
+        // the algorithms are silenced, only the progress of the benchmark is printed
+        std::streambuf* backup = std::cout.rdbuf();
+        null_buffer nb;
+        quality_metrics qm;
+
+        for( unsigned model = 0; model < models.size(); model++) {
+                random_functions::setSeed(config.seed);
+                graph_access C;
+                if( !synthetic_models::generate( models[model], k, C ) ) {
+                        std::cout <<  "unknown model " <<  models[model]  << std::endl;
+                        exit(0);
+                }
+                std::cout <<  "model " <<  models[model] <<  " has " <<  C.number_of_nodes() <<  " nodes, " 
+                          <<  C.number_of_edges() <<  " edges"  << std::endl;
+
+                for( unsigned h = 0; h < hierarchies.size(); h++) {
+                        PartitionConfig system_config = config;
+                        system_config.group_sizes = hierarchies[h].group_sizes;
+                        system_config.distances   = hierarchies[h].distances;
+
+                        matrix* D = NULL;
+                        if( k <= BENCH_MAX_STORED_DISTANCE_MATRIX ) {
+                                system_config.distance_construction_algorithm = DIST_CONST_HIERARCHY;
+                                D = new normal_matrix(k, k);
+                        } else {
+                                system_config.distance_construction_algorithm = DIST_CONST_HIERARCHY_ONLINE;
+                                online_distance_matrix* online_D = new online_distance_matrix(k, k);
+                                online_D->setPartitionConfig(system_config);
+                                D = online_D;
+                        }
+                        std::cout.rdbuf(&nb);
+                        construct_distance_matrix cdm;
+                        if( !cdm.construct_matrix( system_config, *D ) ) exit(0);
+                        std::cout.rdbuf(backup);
+
+                        for( unsigned c = 0; c < constructions.size(); c++) {
+                                for( unsigned ls = 0; ls < neighborhoods.size(); ls++) {
+                                        PartitionConfig run_config = system_config;
+                                        set_construction_algorithm( run_config, constructions[c] );
+                                        set_neighborhood( run_config, neighborhoods[ls] );
+                                        random_functions::setSeed(run_config.seed);
+                                        reset_peak_rss();
+
+                                        std::cout.rdbuf(&nb);
+                                        timer_x t;
+                                        std::vector< NodeID > perm_rank(k);
+                                        construct_mapping cm;
+                                        cm.construct_initial_mapping( run_config, C, *D, perm_rank);
+                                        double construction_time = t.elapsed();
+                                        long long initial_objective = qm.total_qap(C, *D, perm_rank);
+
+                                        t.restart();
+                                        local_search_mapping lsm;
+                                        if( !run_local_search( run_config, C, *D, perm_rank, lsm) ) exit(0);
+                                        double local_search_time = t.elapsed();
+                                        long long objective = qm.total_qap(C, *D, perm_rank);
+                                        std::cout.rdbuf(backup);
+
+                                        csv << models[model] << "," << C.number_of_nodes() << "," << C.number_of_edges() << ","
+                                            << join(hierarchies[h].group_sizes) << "," << join(hierarchies[h].distances) << ","
+                                            << constructions[c] << "," << neighborhoods[ls] << ","
+                                            << construction_time << "," << local_search_time << ","
+                                            << lsm.swaps_evaluated() << "," << lsm.swaps_performed() << ","
+                                            << initial_objective << "," << objective << "," << peak_rss() << std::endl;
+
+                                        std::cout <<  models[model] <<  " " <<  join(hierarchies[h].group_sizes) <<  " " 
+                                                  <<  constructions[c] <<  " " <<  neighborhoods[ls] 
+                                                  <<  " J(C,D,Pi) = " <<  objective 
+                                                  <<  " time " <<  construction_time + local_search_time  << std::endl;
+                                }
+                        }
+                        delete D;
+                }
+        }
+}
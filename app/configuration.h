@@ -148,6 +148,7 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.bipartition_tries                      = 9;
         partition_config.minipreps                              = 10;
         partition_config.enable_omp                             = false;
+        partition_config.num_threads                            = 1;
         partition_config.combine                                = false;
         partition_config.epsilon                                = 3; 
         partition_config.buffoon                                = false;
@@ -263,16 +264,44 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.slow_mapping                           = false;
         partition_config.preconfiguration_mapping               = PRE_CONFIG_MAPPING_ECO;
         partition_config.max_recursion_levels_construction      = std::numeric_limits< int >::max();
+        partition_config.enable_hierarchy_partitioning          = false;
+        partition_config.previous_mapping                       = "";
+        partition_config.checkpoint_filename                    = "";
+        partition_config.checkpoint_interval                    = 10;
+        partition_config.resume_from_checkpoint                 = false;
+        partition_config.gap_threshold                          = 0;
+        partition_config.qap_lower_bound                        = 0;
+        partition_config.relabeling                             = RELABEL_NONE;
+        partition_config.bench_models                           = "grid2d,grid3d,rgg,powerlaw,alltoall";
+        partition_config.bench_construction_algorithms          = "random,identity,growing,hierarchybottomup,hierarchytopdown";
+        partition_config.bench_neighborhoods                    = "nsquare,nsquarepruned,communication";
+        partition_config.report_filename                        = "";
+        partition_config.enable_perf_counters                   = false;
+        partition_config.enable_memory_counters                 = false;
+        partition_config.trace_filename                         = "";
+        partition_config.trace_interval                         = 1000;
+        partition_config.socket_filename                        = "/tmp/viem.sock";
+        partition_config.previous_model                         = "";
         partition_config.enable_cycle_local_search              = false;
         partition_config.enable_group_local_search              = false;
+        partition_config.enable_tabu_search                     = false;
+        partition_config.enable_exact_group_search              = false;
+        partition_config.exact_group_max_tasks                  = 10;
+        partition_config.enable_evolutionary_mapping            = false;
+        partition_config.evolutionary_generations               = 100;
+        partition_config.num_islands                            = 0;
+        partition_config.deterministic                          = false;
 
 
+        // standard is called again by the preconfigurations
+        partition_config.group_sizes.clear();
         partition_config.group_sizes.push_back(4);
         partition_config.group_sizes.push_back(8);
         partition_config.group_sizes.push_back(4);
         partition_config.group_sizes.push_back(1);
         partition_config.group_sizes.push_back(1);
 
+        partition_config.distances.clear();
         partition_config.distances.push_back(1);
         partition_config.distances.push_back(5);
         partition_config.distances.push_back(10);
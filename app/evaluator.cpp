@@ -28,6 +28,7 @@
 #include "data_structure/matrix/online_distance_matrix.h"
 #include "graph_io.h"
 #include "macros_assertions.h"
+#include "mapping/qap_lower_bound.h"
 #include "parse_parameters.h"
 #include "partition/partition_config.h"
 #include "quality_metrics.h"
@@ -80,9 +81,31 @@ int main(int argn, char **argv) {
         online_distance_matrix D(config.k, config.k);
         D.setPartitionConfig(config);
 
+        // blocks are the groups of the lowest level of the hierarchy, i.e. the cut is the 
+        // communication that leaves a processor
+        PartitionID group_size = config.group_sizes.size() > 0 ? config.group_sizes[0] : 1;
+        C.set_partition_count(config.k / group_size);
+        forall_nodes(C, node) {
+                C.setPartitionIndex(node, input_mapping[node] / group_size);
+        } endfor
+
         quality_metrics qm;
-        NodeWeight qap = qm.total_qap(C, D, input_mapping);
+        qm.set_num_threads(config.num_threads);
+        partition_metrics metrics;
+        qm.compute_all(C, metrics, &D, &input_mapping);
+        long long qap = metrics.qap;
         std::cout <<  "quadratic assignment objective J(C,D,Pi') = " << qap << std::endl;
+        std::cout <<  "cut between groups of " << group_size << " PEs \t\t" << metrics.edge_cut << std::endl;
+        std::cout <<  "max comm vol \t\t\t\t" << metrics.max_communication_volume << std::endl;
+        std::cout <<  "total comm vol \t\t\t\t" << metrics.total_communication_volume << std::endl;
+        std::cout <<  "boundary tasks \t\t\t\t" << metrics.boundary_nodes << std::endl;
+        std::cout <<  "balance \t\t\t\t" << metrics.balance << std::endl;
+        C.set_partition_count(config.k);
+
+        qap_lower_bound qlb;
+        long lower_bound = qlb.hierarchy_gilmore_lawler(config, C);
+        std::cout <<  "lower bound " <<  lower_bound 
+                  <<  ", gap " <<  qap_lower_bound::gap( qap, lower_bound ) << "%" << std::endl;
 
 
 
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * viem.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment 
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz 
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <argtable2.h>
+#include <iostream>
+#include <math.h>
+#include <omp.h>
+#include <regex.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h> 
+
+#include "balance_configuration.h"
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/normal_matrix.h"
+#include "data_structure/matrix/online_distance_matrix.h"
+#include "graph_io.h"
+#include "macros_assertions.h"
+#include "parse_parameters.h"
+#include "partition/graph_partitioner.h"
+#include "partition/partition_config.h"
+#include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
+#include "mapping/hierarchy_partitioning.h"
+#include "mapping/mapping_algorithms.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "timer.h"
+
+// partitions the application graph, builds the model of computation and communication
+// in memory and maps it onto the specified hierarchy (generate_model + viem in one run)
+int main(int argn, char **argv) {
+
+        PartitionConfig config;
+        std::string graph_filename;
+
+        bool is_graph_weighted = false;
+        bool suppress_output   = false;
+        bool recursive         = false;
+       
+        int ret_code = parse_parameters(argn, argv, 
+                                        config, 
+                                        graph_filename, 
+                                        is_graph_weighted, 
+                                        suppress_output, recursive); 
+
+        if(ret_code) {
+                return 0;
+        }
+
+        std::streambuf* backup = std::cout.rdbuf();
+        std::ofstream ofs;
+        ofs.open("/dev/null");
+        if(suppress_output) {
+                std::cout.rdbuf(ofs.rdbuf()); 
+        }
+
+        if(config.group_sizes.size() == 0 || config.group_sizes.size() != config.distances.size()) {
+                std::cout <<  "Please specify the system hierarchy (using the --hierarchy_parameter_string and --distance_parameter_string options)."  << std::endl;
+                exit(0);
+        }
+
+        // one block per PE
+        config.k = 1;
+        for( unsigned i = 0; i < config.group_sizes.size(); i++) {
+                config.k *= config.group_sizes[i];
+        }
+
+        // all stages use the same number of threads
+        omp_set_num_threads(std::max(1, config.num_threads));
+
+        config.LogDump(stdout);
+        graph_access G;     
+
+        timer_x t;
+        timer_x total_t;
+        graph_io::readGraphWeighted(G, graph_filename);
+        double io_time = t.elapsed();
+        std::cout << "io time: " << io_time  << std::endl;
+       
+        // the partitioner modifies its configuration, the mapping starts from the parsed one
+        PartitionConfig map_config = config;
+
+        G.set_partition_count(config.k); 
+
+        balance_configuration bc;
+        bc.configurate_balance( config, G);
+
+        srand(config.seed);
+        random_functions::setSeed(config.seed);
+
+        std::cout <<  "graph has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges() <<  " edges"  << std::endl;
+        // ***************************** perform partitioning ***************************************       
+        t.restart();
+        std::cout <<  "performing partitioning! " << std::endl;
+
+        if( config.enable_hierarchy_partitioning ) {
+                hierarchy_partitioning hp;
+                hp.perform_partitioning(config, G);
+        } else {
+                graph_partitioner partitioner;
+                partitioner.perform_partitioning(config, G);
+        }
+
+        double partitioning_time = t.elapsed();
+        std::cout << "partitioning took " << partitioning_time  << std::endl;
+
+        // ***************************** build model ***************************************       
+        t.restart();
+        graph_access C;
+        complete_boundary boundary(&G);
+        boundary.build();
+        boundary.getUnderlyingQuotientGraph(C);
+
+        forall_nodes(C, node) {
+                C.setNodeWeight(node, 1);
+        } endfor
+
+        double model_time = t.elapsed();
+        std::cout <<  "model has " << C.number_of_nodes() << " nodes, " << C.number_of_edges() <<  " edges "  << std::endl;
+        std::cout <<  "building the model took " << model_time  << std::endl;
+
+        if(map_config.k != C.number_of_nodes() ) {
+                std::cout <<  "The number of nodes of the model does not match specified system entities."  << std::endl;
+                exit(0);
+        }
+
+        // ***************************** perform mapping ***************************************       
+        t.restart();
+        quality_metrics qm;
+        qm.set_num_threads(map_config.num_threads);
+        mapping_algorithms ma;
+        std::vector< NodeID > perm_rank(map_config.k);
+
+        long long qap = 0;
+        if( map_config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
+                normal_matrix D(map_config.k, map_config.k);
+                if( !ma.construct_a_mapping(map_config, C, D, perm_rank) ) exit(0);
+                qap = qm.total_qap(C, D, perm_rank );
+        } else {
+                online_distance_matrix D(map_config.k, map_config.k);
+                D.setPartitionConfig(map_config);
+                if( !ma.construct_a_mapping(map_config, C, D, perm_rank) ) exit(0);
+                qap = qm.total_qap(C, D, perm_rank );
+        }
+        double mapping_time = t.elapsed();
+        std::cout <<  "time spent for mapping " << mapping_time  << std::endl;
+        std::cout <<  "quadratic assignment objective J(C,D,Pi') = " << qap << std::endl;
+
+        // ***************************** write output ***************************************       
+        t.restart();
+        std::stringstream partition_filename;
+        partition_filename << "tmppartition" << map_config.k;
+        graph_io::writePartition(G, partition_filename.str());
+
+        // task to PE assignment of the application graph: node -> block -> PE
+        std::vector< NodeID > node_to_PE(G.number_of_nodes());
+        forall_nodes(G, node) {
+                node_to_PE[node] = perm_rank[G.getPartitionIndex(node)];
+        } endfor
+
+        std::stringstream filename;
+        if(!map_config.filename_output.compare("")) {
+                filename << "mapping";
+        } else {
+                filename << map_config.filename_output;
+        }
+        graph_io::writeVector( node_to_PE, filename.str());
+        double output_time = t.elapsed();
+
+        std::cout <<  "writing mapping to " << filename.str() << std::endl;
+        std::cout <<  "phase timings: io " << io_time 
+                  <<  " partitioning " << partitioning_time 
+                  <<  " model " << model_time 
+                  <<  " mapping " << mapping_time 
+                  <<  " output " << output_time 
+                  <<  " total " << total_t.elapsed() << std::endl;
+
+        ofs.close();
+        std::cout.rdbuf(backup);
+}
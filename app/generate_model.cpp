@@ -37,9 +37,11 @@
 #include "partition/graph_partitioner.h"
 #include "partition/partition_config.h"
 #include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
+#include "mapping/hierarchy_partitioning.h"
 #include "mapping/mapping_algorithms.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
+#include "run_report.h"
 #include "timer.h"
 
 int main(int argn, char **argv) {
@@ -68,11 +70,32 @@ int main(int argn, char **argv) {
                 std::cout.rdbuf(ofs.rdbuf()); 
         }
 
+        if( config.enable_hierarchy_partitioning ) {
+                int num_PEs = 1;
+                for( unsigned i = 0; i < config.group_sizes.size(); i++) {
+                        num_PEs *= config.group_sizes[i];
+                }
+                if( num_PEs != (int)config.k ) {
+                        std::cout <<  "The number of blocks does not match specified system entities. Please provide correct input parameters (using the --hierarchy_parameter_string option)."  << std::endl;
+                        exit(0);
+                }
+        }
+
         config.LogDump(stdout);
+
+        if( config.report_filename != "" ) {
+                run_report::enable();
+                if( config.enable_memory_counters ) {
+                        run_report::enable_memory_counters();
+                }
+        }
+
         graph_access G;     
 
         timer_x t;
+        run_report::begin_phase("io");
         graph_io::readGraphWeighted(G, graph_filename);
+        run_report::end_phase();
         std::cout << "io time: " << t.elapsed()  << std::endl;
        
         G.set_partition_count(config.k); 
@@ -92,18 +115,26 @@ int main(int argn, char **argv) {
         std::cout <<  "graph has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges() <<  " edges"  << std::endl;
         // ***************************** perform partitioning ***************************************       
         t.restart();
-        graph_partitioner partitioner;
-
         std::cout <<  "performing partitioning! " << std::endl;
 
-        partitioner.perform_partitioning(config, G);
+        run_report::begin_phase("partitioning");
+        if( config.enable_hierarchy_partitioning ) {
+                hierarchy_partitioning hp;
+                hp.perform_partitioning(config, G);
+        } else {
+                graph_partitioner partitioner;
+                partitioner.perform_partitioning(config, G);
+        }
 
+        run_report::end_phase();
         std::cout << "partitioning took " << t.elapsed()  << std::endl;
 
+        run_report::begin_phase("quotient_graph");
         graph_access C;
         complete_boundary boundary(&G);
         boundary.build();
         boundary.getUnderlyingQuotientGraph(C);
+        run_report::end_phase();
 
         forall_nodes(C, node) {
                 C.setNodeWeight(node, 1);
@@ -118,7 +149,13 @@ int main(int argn, char **argv) {
                 filename << config.filename_output;
         }
 
+        run_report::begin_phase("output");
         graph_io::writeGraphWeighted( C, filename.str());
+        run_report::end_phase();
+
+        if( config.report_filename != "" && !run_report::write( config.report_filename, "generate_model" ) ) {
+                std::cout <<  "could not write report to " <<  config.report_filename  << std::endl;
+        }
          
         ofs.close();
         std::cout.rdbuf(backup);
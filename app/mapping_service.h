@@ -0,0 +1,77 @@
+/******************************************************************************
+ * mapping_service.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment 
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz 
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef MAPPING_SERVICE_8VQ3NLTD
+#define MAPPING_SERVICE_8VQ3NLTD
+
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "viem_interface.h"
+
+// protocol between viem_server and its clients over a unix domain socket (host byte order):
+//   request:  service_request_header, group_sizes[hierarchy_depth], distances[hierarchy_depth],
+//             xadj[n+1], adjncy[m], adjcwgt[m]  (all int32, CSR as in the library interface)
+//   response: service_response_header, perm_rank[n] (int32, only if status == VIEM_OK)
+#define VIEM_SERVICE_MAGIC            0x4d454956
+#define VIEM_ERROR_INVALID_REQUEST    4
+
+struct service_request_header {
+        int32_t magic;
+        int32_t mode_mapping;     // VIEM_MAPMODE_*
+        int32_t seed;
+        int32_t hierarchy_depth;
+        int32_t n;
+        int32_t m;                // number of (directed) edges, i.e. xadj[n]
+};
+
+struct service_response_header {
+        int32_t status;           // VIEM_OK or VIEM_ERROR_*
+        int32_t n;
+        int64_t qap;              // J(C,D,perm_rank)
+};
+
+inline bool service_read( int fd, void* buffer, size_t length ) {
+        char* pos = (char*) buffer;
+        while( length > 0 ) {
+                ssize_t bytes = read(fd, pos, length);
+                if( bytes < 0 && errno == EINTR ) continue;
+                if( bytes <= 0 ) return false;
+                pos    += bytes;
+                length -= bytes;
+        }
+        return true;
+}
+
+inline bool service_write( int fd, const void* buffer, size_t length ) {
+        const char* pos = (const char*) buffer;
+        while( length > 0 ) {
+                ssize_t bytes = write(fd, pos, length);
+                if( bytes < 0 && errno == EINTR ) continue;
+                if( bytes <= 0 ) return false;
+                pos    += bytes;
+                length -= bytes;
+        }
+        return true;
+}
+
+#endif /* end of include guard: MAPPING_SERVICE_8VQ3NLTD */
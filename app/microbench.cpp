@@ -0,0 +1,373 @@
+/******************************************************************************
+ * microbench.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/normal_matrix.h"
+#include "data_structure/matrix/online_distance_matrix.h"
+#include "data_structure/priority_queues/bucket_pq.h"
+#include "data_structure/priority_queues/maxNodeHeap.h"
+#include "partition/partition_config.h"
+#include "random_functions.h"
+#include "synthetic_models.h"
+#include "timer.h"
+
+// microbenchmarks of the primitives the mapping algorithms spend their time in.
+// every benchmark performs a given number of operations and the number is increased
+// until a run takes at least the minimum time. the reported time per operation is the
+// minimum (and median) over MICROBENCH_REPETITIONS runs. random access patterns use
+// precomputed indices, hence their time includes one additional sequential load.
+// benchmarks of whole vectors (shuffles) round the number of operations up to full vectors.
+
+#define MICROBENCH_REPETITIONS 5
+#define MICROBENCH_RANDOM_INDICES (1 << 20) // has to be a power of two
+
+// results are added up here so that the compiler cannot drop the work
+static volatile long long microbench_sink = 0;
+
+static std::string filter;
+static double min_time = 0.2;
+
+static std::string benchmark_name( std::string primitive, std::string operation, std::string pattern, unsigned size ) {
+        std::stringstream name;
+        name << primitive << "/" << operation << "/" << pattern << "/" << size;
+        return name.str();
+}
+
+static bool selected( const std::string & name ) {
+        return name.find(filter) != std::string::npos;
+}
+
+// benchmark(iterations) has to perform exactly iterations operations and return a checksum
+template< typename Benchmark >
+static void run( const std::string & name, Benchmark benchmark ) {
+        if( !selected(name) ) return;
+
+        long long iterations = 1;
+        timer_x t;
+        while( true ) {
+                t.restart();
+                microbench_sink += benchmark(iterations);
+                double elapsed = t.elapsed();
+                if( elapsed >= min_time || iterations >= (1LL << 40) ) break;
+
+                // aim a bit above the minimum time to avoid another round
+                long long next = elapsed > 0 ? (long long)(1.4*min_time/elapsed*iterations) : 10*iterations;
+                iterations = std::max( 2*iterations, std::min( next, 100*iterations ) );
+        }
+
+        std::vector< double > ns_per_op;
+        for( unsigned i = 0; i < MICROBENCH_REPETITIONS; i++) {
+                t.restart();
+                microbench_sink += benchmark(iterations);
+                ns_per_op.push_back( 1e9*t.elapsed()/iterations );
+        }
+        std::sort( ns_per_op.begin(), ns_per_op.end() );
+
+        std::cout <<  std::left << std::setw(56) << name << std::right << std::fixed << std::setprecision(2)
+                  <<  std::setw(14) << ns_per_op[0] 
+                  <<  std::setw(14) << ns_per_op[ns_per_op.size()/2] 
+                  <<  std::setw(16) << iterations << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+}
+
+static std::vector< unsigned > random_indices( unsigned bound ) {
+        std::vector< unsigned > indices( MICROBENCH_RANDOM_INDICES );
+        for( unsigned i = 0; i < indices.size(); i++) {
+                indices[i] = random_functions::nextInt(0, bound - 1);
+        }
+        return indices;
+}
+
+// three level hierarchy with 4 cores per socket, 16 sockets per node and k/64 nodes
+static void hierarchy_config( unsigned k, PartitionConfig & config ) {
+        config.group_sizes.clear();
+        config.group_sizes.push_back(4);
+        config.group_sizes.push_back(16);
+        config.group_sizes.push_back(std::max(1u, k/64));
+        config.distances.clear();
+        config.distances.push_back(1);
+        config.distances.push_back(10);
+        config.distances.push_back(100);
+}
+
+// the matrices are accessed through the interface as in the mapping algorithms
+static void __attribute__ ((noinline)) bench_matrix( std::string primitive, matrix & D ) {
+        unsigned k = D.get_x_dim();
+        run( benchmark_name(primitive, "get_xy", "sequential", k), [&]( long long iterations ) {
+                long long sum = 0;
+                unsigned x = 0, y = 0;
+                for( long long i = 0; i < iterations; i++) {
+                        sum += D.get_xy(x, y);
+                        if( ++y == k ) { 
+                                y = 0; 
+                                if( ++x == k ) x = 0; 
+                        }
+                }
+                return sum;
+        });
+
+        std::vector< unsigned > xs = random_indices(k);
+        std::vector< unsigned > ys = random_indices(k);
+        run( benchmark_name(primitive, "get_xy", "random", k), [&]( long long iterations ) {
+                long long sum = 0;
+                for( long long i = 0; i < iterations; i++) {
+                        unsigned idx = i & (MICROBENCH_RANDOM_INDICES - 1);
+                        sum += D.get_xy(xs[idx], ys[idx]);
+                }
+                return sum;
+        });
+}
+
+static void bench_matrices() {
+        unsigned normal_sizes[] = {256, 1024, 4096};
+        for( unsigned k : normal_sizes ) {
+                if( !selected(benchmark_name("normal_matrix", "get_xy", "sequential", k)) 
+                 && !selected(benchmark_name("normal_matrix", "get_xy", "random", k)) ) continue;
+
+                PartitionConfig config;
+                hierarchy_config(k, config);
+                online_distance_matrix online(k, k);
+                online.setPartitionConfig(config);
+
+                normal_matrix D(k, k);
+                for( unsigned x = 0; x < k; x++) {
+                        for( unsigned y = 0; y < k; y++) {
+                                D.set_xy(x, y, online.get_xy(x, y));
+                        }
+                }
+                bench_matrix( "normal_matrix", D );
+        }
+
+        unsigned online_sizes[] = {256, 4096, 65536, 1048576};
+        for( unsigned k : online_sizes ) {
+                PartitionConfig config;
+                hierarchy_config(k, config);
+                online_distance_matrix D(k, k);
+                D.setPartitionConfig(config);
+                bench_matrix( "online_distance_matrix", D );
+        }
+}
+
+// one operation is one edge visited (target and weight), nodes are visited in the given order
+static long long scan_edges( graph_access & G, std::vector< NodeID > & order, long long iterations ) {
+        long long sum = 0, visited = 0;
+        NodeID i = 0;
+        while( visited < iterations ) {
+                NodeID node = order[i];
+                forall_out_edges(G, e, node) {
+                        sum += G.getEdgeTarget(e) + G.getEdgeWeight(e);
+                } endfor
+                visited += G.getNodeDegree(node);
+                if( ++i == order.size() ) i = 0;
+        }
+        return sum;
+}
+
+static void bench_graphs() {
+        std::string models[] = {"grid2d", "rgg"};
+        unsigned sizes[] = {4096, 65536, 1048576};
+        for( std::string model : models ) {
+                for( unsigned n : sizes ) {
+                        std::string sequential = benchmark_name("graph_access/" + model, "edges", "sequential", n);
+                        std::string random     = benchmark_name("graph_access/" + model, "edges", "random", n);
+                        if( !selected(sequential) && !selected(random) ) continue;
+
+                        graph_access G;
+                        synthetic_models::generate(model, n, G);
+
+                        std::vector< NodeID > order(G.number_of_nodes());
+                        for( unsigned i = 0; i < order.size(); i++) order[i] = i;
+                        run( sequential, [&]( long long iterations ) {
+                                return scan_edges(G, order, iterations);
+                        });
+
+                        random_functions::permutate_vector_good(order, false);
+                        run( random, [&]( long long iterations ) {
+                                return scan_edges(G, order, iterations);
+                        });
+                }
+        }
+}
+
+// steady state: the queue holds n elements, one operation is a deleteMax followed by an insert
+// or a changeKey of an element. keys are random in [-gain_span, gain_span].
+static void __attribute__ ((noinline)) bench_queue( std::string primitive, priority_queue_interface & queue, unsigned n, int gain_span ) {
+        std::vector< unsigned > keys = random_indices(2*gain_span + 1);
+        for( NodeID node = 0; node < n; node++) {
+                queue.insert( node, (int)keys[node & (MICROBENCH_RANDOM_INDICES - 1)] - gain_span );
+        }
+
+        run( benchmark_name(primitive, "deletemax_insert", "random", n), [&]( long long iterations ) {
+                long long sum = 0;
+                for( long long i = 0; i < iterations; i++) {
+                        NodeID node = queue.deleteMax();
+                        queue.insert( node, (int)keys[i & (MICROBENCH_RANDOM_INDICES - 1)] - gain_span );
+                        sum += node;
+                }
+                return sum;
+        });
+
+        run( benchmark_name(primitive, "changekey", "sequential", n), [&]( long long iterations ) {
+                NodeID node = 0;
+                for( long long i = 0; i < iterations; i++) {
+                        queue.changeKey( node, (int)keys[i & (MICROBENCH_RANDOM_INDICES - 1)] - gain_span );
+                        if( ++node == n ) node = 0;
+                }
+                return (long long) queue.maxValue();
+        });
+
+        std::vector< unsigned > nodes = random_indices(n);
+        run( benchmark_name(primitive, "changekey", "random", n), [&]( long long iterations ) {
+                for( long long i = 0; i < iterations; i++) {
+                        unsigned idx = i & (MICROBENCH_RANDOM_INDICES - 1);
+                        queue.changeKey( nodes[idx], (int)keys[idx] - gain_span );
+                }
+                return (long long) queue.maxValue();
+        });
+}
+
+static void bench_queues() {
+        unsigned sizes[] = {1024, 65536, 1048576};
+        int gain_span = 1000;
+        for( unsigned n : sizes ) {
+                maxNodeHeap heap;
+                bench_queue( "maxNodeHeap", heap, n, gain_span );
+
+                bucket_pq bucket_queue(gain_span);
+                bench_queue( "bucket_pq", bucket_queue, n, gain_span );
+        }
+}
+
+// the generator and distributions as random_functions used them before, for comparison
+static std::mt19937 reference_mt;
+
+static void reference_permutate_vector_good( std::vector< std::pair< NodeID, NodeID > > & vec ) {
+        unsigned int size = vec.size();
+        std::uniform_int_distribution<unsigned int> A(0,size - 4);
+        std::uniform_int_distribution<unsigned int> B(0,size - 4);
+        for( unsigned int i = 0; i < size; i++) {
+                unsigned int posA = A(reference_mt);
+                unsigned int posB = B(reference_mt);
+                std::swap(vec[posA], vec[posB]); 
+                std::swap(vec[posA+1], vec[posB+1]); 
+                std::swap(vec[posA+2], vec[posB+2]); 
+                std::swap(vec[posA+3], vec[posB+3]); 
+        }
+}
+
+// one operation is one number or one element of a shuffled vector
+static void bench_random() {
+        run( benchmark_name("std_mt19937", "nextBool", "uniform", 2), []( long long iterations ) {
+                long long sum = 0;
+                for( long long i = 0; i < iterations; i++) {
+                        std::uniform_int_distribution<unsigned int> A(0,1);
+                        sum += A(reference_mt);
+                }
+                return sum;
+        });
+        run( benchmark_name("random_functions", "nextBool", "uniform", 2), []( long long iterations ) {
+                long long sum = 0;
+                for( long long i = 0; i < iterations; i++) {
+                        sum += random_functions::nextBool();
+                }
+                return sum;
+        });
+
+        unsigned ranges[] = {10, 1000000};
+        for( unsigned range : ranges ) {
+                run( benchmark_name("std_mt19937", "nextInt", "uniform", range), [&]( long long iterations ) {
+                        long long sum = 0;
+                        for( long long i = 0; i < iterations; i++) {
+                                std::uniform_int_distribution<unsigned int> A(0, range - 1);
+                                sum += A(reference_mt);
+                        }
+                        return sum;
+                });
+                run( benchmark_name("random_functions", "nextInt", "uniform", range), [&]( long long iterations ) {
+                        long long sum = 0;
+                        for( long long i = 0; i < iterations; i++) {
+                                sum += random_functions::nextInt(0, range - 1);
+                        }
+                        return sum;
+                });
+        }
+
+        unsigned sizes[] = {1024, 1048576};
+        for( unsigned n : sizes ) {
+                std::vector< std::pair< NodeID, NodeID > > pairs(n);
+                for( unsigned i = 0; i < n; i++) pairs[i] = std::make_pair(i, n - i);
+
+                run( benchmark_name("std_mt19937", "permutate_vector_good", "pairs", n), [&]( long long iterations ) {
+                        for( long long done = 0; done < iterations; done += n) {
+                                reference_permutate_vector_good(pairs);
+                        }
+                        return (long long) pairs[0].first;
+                });
+                run( benchmark_name("random_functions", "permutate_vector_good", "pairs", n), [&]( long long iterations ) {
+                        for( long long done = 0; done < iterations; done += n) {
+                                random_functions::permutate_vector_good(pairs);
+                        }
+                        return (long long) pairs[0].first;
+                });
+
+                std::vector< NodeID > nodes(n);
+                for( unsigned i = 0; i < n; i++) nodes[i] = i;
+                run( benchmark_name("random_functions", "shuffle", "nodes", n), [&]( long long iterations ) {
+                        for( long long done = 0; done < iterations; done += n) {
+                                random_functions::shuffle(nodes);
+                        }
+                        return (long long) nodes[0];
+                });
+        }
+}
+
+int main(int argn, char **argv) {
+        if( argn > 3 || (argn > 1 && std::string(argv[1]) == "--help") ) {
+                std::cout <<  "Usage: microbench [FILTER] [MIN_TIME]"  << std::endl;
+                std::cout <<  "  runs the benchmarks whose name contains FILTER, each for at least MIN_TIME seconds (default 0.2)"  << std::endl;
+                exit(0);
+        }
+        if( argn > 1 ) filter   = argv[1];
+        if( argn > 2 ) min_time = atof(argv[2]);
+
+        random_functions::setSeed(0);
+
+        std::cout <<  std::left << std::setw(56) << "benchmark" << std::right 
+                  <<  std::setw(14) << "min ns/op" 
+                  <<  std::setw(14) << "median ns/op" 
+                  <<  std::setw(16) << "iterations" << std::endl;
+
+        bench_matrices();
+        bench_graphs();
+        bench_queues();
+        bench_random();
+
+        return 0;
+}
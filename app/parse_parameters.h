@@ -53,6 +53,7 @@ int parse_parameters(int argn, char **argv,
         struct arg_lit *disable_refined_bubbling             = arg_lit0(NULL, "disable_refined_bubbling", "Disables refinement during initial partitioning using bubbling (Default: enabled).");
         struct arg_lit *enable_convergence                   = arg_lit0(NULL, "enable_convergence", "Enables convergence mode, i.e. every step is running until no change.(Default: disabled).");
         struct arg_lit *enable_omp                           = arg_lit0(NULL, "enable_omp", "Enable parallel omp.");
+        struct arg_int *num_threads                          = arg_int0(NULL, "num_threads", NULL, "Number of threads to use. Default: 1.");
         struct arg_lit *wcycle_no_new_initial_partitioning   = arg_lit0(NULL, "wcycle_no_new_initial_partitioning", "Using this option, the graph is initially partitioned only the first time we are at the deepest level.");
         struct arg_str *filename                             = arg_strn(NULL, NULL, "FILE", 1, 1, "Path to file (graph/model).");
         struct arg_str *filename_output                      = arg_str0(NULL, "output_filename", NULL, "Specify the name of the output file.");
@@ -151,13 +152,42 @@ int parse_parameters(int argn, char **argv,
         struct arg_lit *active_pairs                         = arg_lit0(NULL, "active_pairs", "Use the active pairs approach.");
         struct arg_rex *construction_algorithm               = arg_rex0(NULL, "construction_algorithm", "^(random|identity|growing|hierarchybottomup|hierarchytopdown)$", "VARIANT", REG_EXTENDED, "Initial construction algorithm to use. One of random, identity, growing, hierarchybottomup, hierarchytopdown. Default: hierarchytopdown." );
         struct arg_rex *distance_construction_algorithm      = arg_rex0(NULL, "distance_construction_algorithm", "^(hierarchy|hierarchyonline)$", "VARIANT", REG_EXTENDED, "Construction algorithm to use to initially construct the distance matrix. One of hierarchy, hierarchyonline (does not store distance matrix). Default: hierarchy." );
+        struct arg_rex *relabeling                           = arg_rex0(NULL, "relabeling", "^(none|rcm|mapping)$", "VARIANT", REG_EXTENDED, "Renumber the communication graph before local search such that neighbors are close in memory. One of none, rcm (reverse cuthill-mckee), mapping (order of the initial mapping). Default: none." );
+        struct arg_str *bench_models                         = arg_str0(NULL, "bench_models", NULL, "Comma separated list of synthetic models (grid2d,grid3d,rgg,powerlaw,alltoall). Default: all.");
+        struct arg_str *bench_construction_algorithms        = arg_str0(NULL, "bench_construction_algorithms", NULL, "Comma separated list of construction algorithms (random,identity,growing,hierarchybottomup,hierarchytopdown). Default: all.");
+        struct arg_str *bench_neighborhoods                  = arg_str0(NULL, "bench_neighborhoods", NULL, "Comma separated list of local search neighborhoods (nsquare,nsquarepruned,communication). Default: all.");
+#ifdef MODE_GENERATE_MODEL
+        struct arg_str *hierarchy_parameter_string           = arg_str0(NULL, "hierarchy_parameter_string", NULL, "Specify hierarchy as 2:2:... for 2 cores per PE, 2 PEs per node, and so forth (used by --enable_hierarchy_partitioning, the number of PEs has to equal k).");
+#else
         struct arg_str *hierarchy_parameter_string           = arg_str1(NULL, "hierarchy_parameter_string", NULL, "Specify hierarchy as 2:2:... for 2 cores per PE, 2 PEs per node, and so forth.");
+#endif
         struct arg_str *distance_parameter_string            = arg_str1(NULL, "distance_parameter_string", NULL, "Specify distances between different levels as 1:10:... for 2 cores on the same PE have distance 1, and so forth"); 
         struct arg_int *search_space_s			     = arg_int0(NULL, "search_space_s", NULL, "Prune the search space with the paramter s. Default: 64");
         struct arg_int *max_recursion_levels_construction    = arg_int0(NULL, "max_recursion_levels_construction", NULL, "Max recursion levels during construction. Default: infinity");
         struct arg_lit *slow_mapping                         = arg_lit0(NULL, "slow_mapping", "Use the slow computation of gain values (both communication and distances are matricies).");
+        struct arg_lit *enable_hierarchy_partitioning        = arg_lit0(NULL, "enable_hierarchy_partitioning", "Partition recursively along the system hierarchy (top level groups first) such that the block ids are already a good mapping. Default: disabled.");
+        struct arg_str *socket_filename                      = arg_str0(NULL, "socket", NULL, "Unix domain socket of the viem_server. Default: /tmp/viem.sock.");
+        struct arg_str *checkpoint_filename                  = arg_str0(NULL, "checkpoint_filename", NULL, "During local search the best mapping so far is written to this file periodically.");
+        struct arg_dbl *checkpoint_interval                  = arg_dbl0(NULL, "checkpoint_interval", NULL, "Time between two checkpoints in s. Default: 10s.");
+        struct arg_lit *resume_from_checkpoint               = arg_lit0(NULL, "resume", "Start from the mapping in the checkpoint file (if it exists) instead of constructing one.");
+        struct arg_str *report_filename                      = arg_str0(NULL, "report_file", NULL, "Write timings of all phases, counters and peak memory of the run to this file (json).");
+        struct arg_lit *enable_perf_counters                 = arg_lit0(NULL, "perf_counters", "Add cycles, instructions, LLC misses and branch misses of every phase to the report (requires --report_file and perf_event_open).");
+        struct arg_lit *enable_memory_counters               = arg_lit0(NULL, "memory_counters", "Add allocations, allocated bytes, the heap peak and the resident set size of every phase to the report (requires --report_file).");
+        struct arg_str *trace_filename                       = arg_str0(NULL, "trace_file", NULL, "Write samples (time, swaps attempted, swaps accepted, J) of the local search to this file (csv).");
+        struct arg_int *trace_interval                       = arg_int0(NULL, "trace_interval", NULL, "Number of attempted swaps between two samples of the trace. Default: 1000.");
+        struct arg_dbl *gap_threshold                        = arg_dbl0(NULL, "gap_threshold", NULL, "Stop improving the mapping once its gap to the QAP lower bound is at most this value (in percent). Default: disabled.");
+        struct arg_str *previous_mapping                     = arg_str0(NULL, "previous_mapping", NULL, "Mapping of a previous communication graph. If given, this mapping is improved locally instead of computing a new one.");
+        struct arg_str *previous_model                       = arg_str0(NULL, "previous_model", NULL, "Communication graph the previous mapping was computed for. Only tasks whose communication changed are considered then.");
         struct arg_lit *enable_cycle_local_search            = arg_lit0(NULL, "enable_cycle_local_search", "Use local search on cycles.");
         struct arg_lit *enable_group_local_search            = arg_lit0(NULL, "enable_group_local_search", "Use local search in groups.");
+        struct arg_lit *enable_tabu_search                   = arg_lit0(NULL, "enable_tabu_search", "Run tabu search on the mapping after local search (bounded by maxIter iterations, or by what is left of time_limit if it is set).");
+
+        struct arg_lit *enable_exact_group_search            = arg_lit0(NULL, "enable_exact_group_search", "Optimally redistribute small sets of tasks between sibling groups of the lowest hierarchy level.");
+        struct arg_int *exact_group_max_tasks                = arg_int0(NULL, "exact_group_max_tasks", NULL, "Maximum number of tasks solved exactly at once by the exact group search, between 2 and 16. Default: 10.");
+        struct arg_lit *enable_evolutionary_mapping          = arg_lit0(NULL, "enable_evolutionary_mapping", "Improve the mapping with an evolutionary algorithm, one island per thread (bounded by evolutionary_generations per island, or by what is left of time_limit if it is set).");
+        struct arg_int *evolutionary_generations             = arg_int0(NULL, "evolutionary_generations", NULL, "Number of generations per island of the evolutionary algorithm. Default: 100.");
+        struct arg_int *num_islands                          = arg_int0(NULL, "num_islands", NULL, "Number of islands of the evolutionary algorithm. Default: number of threads (4 with --deterministic).");
+        struct arg_lit *deterministic                        = arg_lit0(NULL, "deterministic", "Results only depend on the seed, not on the number of threads or timing. Time limits are ignored, i.e. iteration and generation limits apply.");
 
         struct arg_end *end                                  = arg_end(100);
 
@@ -191,9 +221,9 @@ int parse_parameters(int argn, char **argv,
                 kaba_packing_iterations, kaba_flip_packings, kaba_lsearch_p, kaffpa_perfectly_balanced_refinement, 
                 kaba_unsucc_iterations, kaba_disable_zero_weight_cycles,
                 maxT, maxIter, minipreps, mh_penalty_for_unconnected, mh_enable_kabapE,
-#elif defined MODE_VIEM
+#elif defined MODE_VIEM || defined MODE_VIEM_BATCH
                 //preconfiguration, 
-                //time_limit, 
+                time_limit, 
                 //enforce_balance, 
 		//balance_edges,
                 preconfiguration_mapping,
@@ -204,22 +234,99 @@ int parse_parameters(int argn, char **argv,
                 distance_construction_algorithm,
                 local_search_neighborhood,
                 communication_neighborhood_dist,
+                relabeling,
                 filename_output, 
 		//active_pairs,
 		//search_space_s,
                 //slow_mapping,
                 //max_recursion_levels_construction,
+                previous_mapping,
+                previous_model,
+                checkpoint_filename,
+                checkpoint_interval,
+                resume_from_checkpoint,
+                gap_threshold,
+                report_filename,
+                enable_perf_counters,
+                enable_memory_counters,
+                trace_filename,
+                trace_interval,
                 //enable_cycle_local_search,
                 //enable_group_local_search,
+                enable_tabu_search,
+                maxT, maxIter,
+                enable_exact_group_search,
+                exact_group_max_tasks,
+                enable_evolutionary_mapping,
+                evolutionary_generations,
+                num_islands,
+                mh_pool_size,
+                num_threads,
+                deterministic,
 #elif defined MODE_GENERATE_MODEL
                 k, imbalance,  
                 user_seed,
                 preconfiguration, 
+                enable_hierarchy_partitioning,
+                hierarchy_parameter_string, 
                 filename_output, 
+                report_filename,
+                enable_memory_counters,
+#elif defined MODE_GENERATE_AND_MAP
+                imbalance,  
+                user_seed,
+                preconfiguration, 
+                preconfiguration_mapping,
+                enable_hierarchy_partitioning,
+                hierarchy_parameter_string, 
+                distance_parameter_string,
+                construction_algorithm,
+                distance_construction_algorithm,
+                local_search_neighborhood,
+                communication_neighborhood_dist,
+                relabeling,
+                enable_tabu_search,
+                enable_exact_group_search,
+                enable_evolutionary_mapping,
+                gap_threshold,
+                num_threads,
+                deterministic,
+                filename_output, 
+#elif defined MODE_VIEM_SERVER
+                construction_algorithm,
+                local_search_neighborhood,
+                communication_neighborhood_dist,
+                relabeling,
+                enable_tabu_search,
+                maxT, maxIter,
+                enable_exact_group_search,
+                exact_group_max_tasks,
+                enable_evolutionary_mapping,
+                evolutionary_generations,
+                mh_pool_size,
+                gap_threshold,
+                num_threads,
+                suppress_output,
+#elif defined MODE_VIEM_CLIENT
+                socket_filename,
+                preconfiguration_mapping,
+                user_seed,
+                hierarchy_parameter_string, 
+                distance_parameter_string,
+                filename_output, 
+#elif defined MODE_BENCH
+                k,
+                user_seed,
+                time_limit,
+                bench_models,
+                bench_construction_algorithms,
+                bench_neighborhoods,
+                communication_neighborhood_dist,
 #elif defined MODE_EVALUATOR
                 input_partition,
                 hierarchy_parameter_string, 
                 distance_parameter_string,
+                num_threads,
 #elif defined MODE_PARTITIONTOVERTEXSEPARATOR
                 k, input_partition, 
                 filename_output, 
@@ -278,7 +385,7 @@ int parse_parameters(int argn, char **argv,
         configuration cfg;
         cfg.standard(partition_config);
 
-#ifdef MODE_VIEM
+#if defined MODE_VIEM || defined MODE_VIEM_BATCH || defined MODE_VIEM_SERVER || defined MODE_BENCH
         cfg.eco(partition_config);
 #else
         cfg.strong(partition_config);
@@ -433,6 +540,19 @@ int parse_parameters(int argn, char **argv,
                 }
         }
  
+        if (relabeling->count) {
+                if(strcmp("none", relabeling->sval[0]) == 0) {
+                        partition_config.relabeling = RELABEL_NONE;
+                } else if (strcmp("rcm", relabeling->sval[0]) == 0) {
+                        partition_config.relabeling = RELABEL_RCM;
+                } else if (strcmp("mapping", relabeling->sval[0]) == 0) {
+                        partition_config.relabeling = RELABEL_MAPPING;
+                } else {
+                        fprintf(stderr, "Invalid relabeling variant: \"%s\"\n", relabeling->sval[0]);
+                        exit(0);
+                }
+        }
+
         if (construction_algorithm->count) {
                 if(strcmp("random", construction_algorithm->sval[0]) == 0) {
                         partition_config.construction_algorithm = MAP_CONST_RANDOM;
@@ -458,11 +578,14 @@ int parse_parameters(int argn, char **argv,
                         partition_config.group_sizes.push_back(stoi(s));
                 }       
 
+#if !defined MODE_GENERATE_MODEL && !defined MODE_GENERATE_AND_MAP
+                // generate_model checks the hierarchy against --k, generate_and_map sets k itself
                 partition_config.k = 1; // recompute k 
                 for( unsigned int i = 0; i < partition_config.group_sizes.size(); i++) {
                         partition_config.k *= partition_config.group_sizes[i];
                 }
                 PRINT(std::cout <<  "new k is " <<  partition_config.k  << std::endl;)
+#endif
         }
 
         if(distance_parameter_string->count) {
@@ -610,6 +733,70 @@ int parse_parameters(int argn, char **argv,
                 partition_config.mh_no_mh = true;
         }
 
+        if(enable_hierarchy_partitioning->count > 0) {
+                partition_config.enable_hierarchy_partitioning = true;
+        }
+
+        if(socket_filename->count > 0) {
+                partition_config.socket_filename = socket_filename->sval[0];
+        }
+
+        if(checkpoint_filename->count > 0) {
+                partition_config.checkpoint_filename = checkpoint_filename->sval[0];
+        }
+
+        if(checkpoint_interval->count > 0) {
+                partition_config.checkpoint_interval = checkpoint_interval->dval[0];
+        }
+
+        if(resume_from_checkpoint->count > 0) {
+                partition_config.resume_from_checkpoint = true;
+        }
+
+        if(bench_models->count > 0) {
+                partition_config.bench_models = bench_models->sval[0];
+        }
+
+        if(bench_construction_algorithms->count > 0) {
+                partition_config.bench_construction_algorithms = bench_construction_algorithms->sval[0];
+        }
+
+        if(bench_neighborhoods->count > 0) {
+                partition_config.bench_neighborhoods = bench_neighborhoods->sval[0];
+        }
+
+        if(trace_filename->count > 0) {
+                partition_config.trace_filename = trace_filename->sval[0];
+        }
+
+        if(trace_interval->count > 0) {
+                partition_config.trace_interval = std::max(1, trace_interval->ival[0]);
+        }
+
+        if(enable_perf_counters->count > 0) {
+                partition_config.enable_perf_counters = true;
+        }
+
+        if(enable_memory_counters->count > 0) {
+                partition_config.enable_memory_counters = true;
+        }
+
+        if(report_filename->count > 0) {
+                partition_config.report_filename = report_filename->sval[0];
+        }
+
+        if(gap_threshold->count > 0) {
+                partition_config.gap_threshold = gap_threshold->dval[0];
+        }
+
+        if(previous_mapping->count > 0) {
+                partition_config.previous_mapping = previous_mapping->sval[0];
+        }
+
+        if(previous_model->count > 0) {
+                partition_config.previous_model = previous_model->sval[0];
+        }
+
         if(enable_cycle_local_search->count > 0) {
                 partition_config.enable_cycle_local_search = true;
         }
@@ -618,10 +805,43 @@ int parse_parameters(int argn, char **argv,
                 partition_config.enable_group_local_search = true;
         }
 
+        if(enable_tabu_search->count > 0) {
+                partition_config.enable_tabu_search = true;
+        }
+
         if(enable_omp->count > 0) {
                 partition_config.enable_omp = true;
         }
 
+        if(num_threads->count > 0) {
+                partition_config.num_threads = num_threads->ival[0];
+        }
+
+        if(enable_exact_group_search->count > 0) {
+                partition_config.enable_exact_group_search = true;
+        }
+
+        if(exact_group_max_tasks->count > 0) {
+                // the search enumerates up to (max_tasks)! assignments per unit
+                if(exact_group_max_tasks->ival[0] < 2 || exact_group_max_tasks->ival[0] > 16) {
+                        fprintf(stderr, "Invalid exact_group_max_tasks: %d, has to be between 2 and 16\n", exact_group_max_tasks->ival[0]);
+                        exit(0);
+                }
+                partition_config.exact_group_max_tasks = exact_group_max_tasks->ival[0];
+        }
+
+        if(enable_evolutionary_mapping->count > 0) {
+                partition_config.enable_evolutionary_mapping = true;
+        }
+
+        if(evolutionary_generations->count > 0) {
+                partition_config.evolutionary_generations = evolutionary_generations->ival[0];
+        }
+
+        if(num_islands->count > 0) {
+                partition_config.num_islands = num_islands->ival[0];
+        }
+
         if(compute_vertex_separator->count > 0) {
                 partition_config.compute_vertex_separator = true;
         }
@@ -923,6 +1143,15 @@ int parse_parameters(int argn, char **argv,
                 partition_config.cluster_upperbound = std::numeric_limits< NodeWeight >::max()/2;
         }
 
+        // wall clock limits make the result depend on the machine and its load
+        if(deterministic->count > 0) {
+                partition_config.deterministic = true;
+                if( partition_config.time_limit > 0 ) {
+                        std::cout <<  "deterministic mode: time limit is ignored"  << std::endl;
+                        partition_config.time_limit = 0;
+                }
+        }
+
         return 0;
 }
 
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * regression_stats.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <math.h>
+#include <sstream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// compares the measurements of two builds, see regression.sh. every line of the input 
+// is "build,key,metric,sample,value" with build baseline or candidate. for all metrics lower
+// is better (time, objective). times are noisy, the sample is the repetition of a run and 
+// a change is a regression if the mann-whitney u test over the repetitions rejects equality 
+// at level alpha and the median of the candidate is worse by more than the threshold (in percent).
+// objectives are deterministic for a seed, hence the sample is the seed and every seed is 
+// measured once. the objectives of both builds are paired by seed, a change is a regression 
+// if the wilcoxon signed rank test over the seeds rejects equality at level alpha and the 
+// median of the per seed changes is positive.
+
+struct samples {
+        std::vector< double > baseline;
+        std::vector< double > candidate;
+
+        // objectives by seed
+        std::map< std::string, double > baseline_seed;
+        std::map< std::string, double > candidate_seed;
+};
+
+static double median( std::vector< double > values ) {
+        std::sort( values.begin(), values.end() );
+        unsigned n = values.size();
+        if( n == 0 ) return 0;
+        return n % 2 ? values[n/2] : (values[n/2-1] + values[n/2]) / 2;
+}
+
+// distribution free 95% confidence interval of the median from order statistics,
+// i.e. [x_(j), x_(n-j+1)] for the largest j with P(Bin(n, 1/2) < j) <= 0.025.
+// for less than 6 samples this is [min, max] with a lower confidence.
+static void median_ci( std::vector< double > values, double & lower, double & upper ) {
+        std::sort( values.begin(), values.end() );
+        unsigned n = values.size();
+        if( n == 0 ) { lower = upper = 0; return; }
+
+        unsigned j = 1;
+        double cdf = pow(0.5, n); // P(Bin(n, 1/2) <= 0)
+        double pmf = cdf;
+        for( unsigned i = 1; i < n; i++) {
+                pmf = pmf * (n - i + 1) / i;
+                if( cdf + pmf > 0.025 ) break;
+                cdf += pmf;
+                j = i + 1;
+        }
+        if( cdf > 0.025 ) j = 1;
+        lower = values[j-1];
+        upper = values[n-j];
+}
+
+// two sided p-value of the mann-whitney u test (normal approximation with tie and continuity correction)
+static double mann_whitney( const std::vector< double > & a, const std::vector< double > & b ) {
+        std::vector< std::pair< double, int > > all;
+        for( unsigned i = 0; i < a.size(); i++) all.push_back( std::make_pair(a[i], 0) );
+        for( unsigned i = 0; i < b.size(); i++) all.push_back( std::make_pair(b[i], 1) );
+        std::sort( all.begin(), all.end() );
+
+        double n1 = a.size(), n2 = b.size(), n = n1 + n2;
+        double rank_sum_a = 0, tie_term = 0;
+        for( unsigned i = 0; i < all.size(); ) {
+                unsigned j = i;
+                while( j < all.size() && all[j].first == all[i].first ) j++;
+                double rank = (i + 1 + j) / 2.0; // average rank of the tied group
+                for( unsigned l = i; l < j; l++) {
+                        if( all[l].second == 0 ) rank_sum_a += rank;
+                }
+                double t = j - i;
+                tie_term += t*t*t - t;
+                i = j;
+        }
+
+        double u        = rank_sum_a - n1*(n1+1)/2;
+        double mean     = n1*n2/2;
+        double variance = n1*n2/12 * ((n + 1) - tie_term/(n*(n-1)));
+        if( variance <= 0 ) return 1; // all values are equal
+
+        double z = (fabs(u - mean) - 0.5) / sqrt(variance);
+        if( z < 0 ) z = 0;
+        return erfc( z / sqrt(2.0) );
+}
+
+// two sided exact p-value of the wilcoxon signed rank test of paired differences,
+// zero differences are dropped and tied absolute differences get their average rank
+static double wilcoxon_signed_rank( const std::vector< double > & differences ) {
+        std::vector< std::pair< double, bool > > nonzero;
+        for( unsigned i = 0; i < differences.size(); i++) {
+                if( differences[i] != 0 ) nonzero.push_back( std::make_pair(fabs(differences[i]), differences[i] > 0) );
+        }
+        std::sort( nonzero.begin(), nonzero.end() );
+
+        unsigned n = nonzero.size();
+        if( n == 0 ) return 1; // no differences at all
+
+        // twice the ranks, so that average ranks of ties are integers
+        std::vector< unsigned > rank( n );
+        unsigned positive_rank_sum = 0;
+        for( unsigned i = 0; i < n; ) {
+                unsigned j = i;
+                while( j < n && nonzero[j].first == nonzero[i].first ) j++;
+                for( unsigned l = i; l < j; l++) {
+                        rank[l] = i + 1 + j;
+                        if( nonzero[l].second ) positive_rank_sum += rank[l];
+                }
+                i = j;
+        }
+
+        // distribution of the (doubled) positive rank sum if the signs are random
+        unsigned total = n*(n+1);
+        std::vector< double > count( total + 1, 0 );
+        count[0] = 1;
+        for( unsigned i = 0; i < n; i++) {
+                for( unsigned sum = total; sum >= rank[i]; sum--) {
+                        count[sum] += count[sum - rank[i]];
+                }
+        }
+
+        double lower = 0, upper = 0, all = pow(2.0, n);
+        for( unsigned sum = 0; sum <= total; sum++) {
+                if( sum <= positive_rank_sum ) lower += count[sum] / all;
+                if( sum >= positive_rank_sum ) upper += count[sum] / all;
+        }
+        return std::min( 1.0, 2*std::min(lower, upper) );
+}
+
+int main(int argn, char **argv) {
+        if( argn < 2 || argn > 4 ) {
+                std::cout <<  "Usage: regression_stats FILE [ALPHA] [THRESHOLD]"  << std::endl;
+                std::cout <<  "  ALPHA significance level (default 0.05), THRESHOLD minimum slowdown in percent (default 2)"  << std::endl;
+                exit(0);
+        }
+
+        std::string filename(argv[1]);
+        double alpha     = argn > 2 ? atof(argv[2]) : 0.05;
+        double threshold = argn > 3 ? atof(argv[3]) : 2;
+
+        std::ifstream in(filename.c_str());
+        if (!in) {
+                std::cerr << "Error opening " << filename << std::endl;
+                return 1;
+        }
+
+        // keep the order of the measurements in the output
+        std::vector< std::string > order;
+        std::map< std::string, samples > data;
+        std::string line;
+        while( std::getline(in, line) ) {
+                if( line.size() == 0 || line[0] == '%' ) continue;
+                std::stringstream ss(line);
+                std::string build, key, metric, sample, value;
+                if( !std::getline(ss, build, ',') || !std::getline(ss, key, ',') 
+                 || !std::getline(ss, metric, ',') || !std::getline(ss, sample, ',') 
+                 || !std::getline(ss, value) ) {
+                        std::cerr << "invalid line: " << line << std::endl;
+                        continue;
+                }
+                std::string id = key + " " + metric;
+                if( data.find(id) == data.end() ) order.push_back(id);
+
+                samples & s = data[id];
+                double v    = atof(value.c_str());
+                if( build == "baseline" ) s.baseline.push_back( v );
+                else                      s.candidate.push_back( v );
+
+                if( metric == "objective" ) {
+                        if( build == "baseline" ) s.baseline_seed[sample]  = v;
+                        else                      s.candidate_seed[sample] = v;
+                }
+        }
+
+        std::cout <<  std::left << std::setw(44) << "measurement" 
+                  <<  std::right << std::setw(34) << "baseline median [95% ci]" 
+                  <<  std::setw(34) << "candidate median [95% ci]" 
+                  <<  std::setw(10) << "change" 
+                  <<  std::setw(10) << "p" << "  verdict" << std::endl;
+
+        unsigned regressions = 0;
+        for( unsigned i = 0; i < order.size(); i++) {
+                samples & s = data[order[i]];
+                double base_median = median( s.baseline );
+                double cand_median = median( s.candidate );
+                double base_lower, base_upper, cand_lower, cand_upper;
+                median_ci( s.baseline, base_lower, base_upper );
+                median_ci( s.candidate, cand_lower, cand_upper );
+                double p      = mann_whitney( s.baseline, s.candidate );
+                double change = base_median != 0 ? 100*(cand_median - base_median)/base_median : 0;
+                double minimum = threshold;
+
+                bool is_objective = !s.baseline_seed.empty() || !s.candidate_seed.empty();
+                if( is_objective ) {
+                        // paired by seed, only seeds measured for both builds count
+                        std::vector< double > differences, changes;
+                        std::map< std::string, double >::iterator it;
+                        for( it = s.baseline_seed.begin(); it != s.baseline_seed.end(); ++it) {
+                                if( s.candidate_seed.find(it->first) == s.candidate_seed.end() ) continue;
+                                double base = it->second;
+                                double cand = s.candidate_seed[it->first];
+                                differences.push_back( cand - base );
+                                changes.push_back( base != 0 ? 100*(cand - base)/base : 0 );
+                        }
+                        p       = wilcoxon_signed_rank( differences );
+                        change  = median( changes );
+                        minimum = 0;
+                }
+
+                std::string verdict = "";
+                if( p < alpha && change > minimum ) {
+                        verdict = "REGRESSION";
+                        regressions++;
+                } else if( p < alpha && change < -minimum ) {
+                        verdict = "improvement";
+                }
+
+                std::stringstream base, cand;
+                base << std::setprecision(6) << base_median << " [" << base_lower << ", " << base_upper << "]";
+                cand << std::setprecision(6) << cand_median << " [" << cand_lower << ", " << cand_upper << "]";
+                std::cout <<  std::left << std::setw(44) << order[i] 
+                          <<  std::right << std::setw(34) << base.str() 
+                          <<  std::setw(34) << cand.str() 
+                          <<  std::setw(9) << std::fixed << std::setprecision(2) << change << "%" 
+                          <<  std::setw(10) << std::setprecision(4) << p << "  " << verdict << std::endl;
+                std::cout.unsetf(std::ios::fixed);
+        }
+
+        std::cout <<  regressions << " regression(s) found"  << std::endl;
+        return regressions > 0 ? 1 : 0;
+}
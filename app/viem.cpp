@@ -38,10 +38,22 @@
 #include "partition/partition_config.h"
 #include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
 #include "mapping/mapping_algorithms.h"
+#include "mapping/qap_lower_bound.h"
+#include "run_report.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
 #include "timer.h"
 
+// true if every task is assigned to a different PE in [0,k)
+static bool is_permutation( std::vector< NodeID > & perm_rank, NodeID k ) {
+        std::vector< bool > used(k, false);
+        for( unsigned i = 0; i < perm_rank.size(); i++) {
+                if( perm_rank[i] >= k || used[perm_rank[i]] ) return false;
+                used[perm_rank[i]] = true;
+        }
+        return true;
+}
+
 int main(int argn, char **argv) {
 
         PartitionConfig config;
@@ -70,9 +82,21 @@ int main(int argn, char **argv) {
 
         config.LogDump(stdout);
 
+        if( config.report_filename != "" ) {
+                run_report::enable();
+                if( config.enable_perf_counters && !run_report::enable_perf_counters() ) {
+                        std::cout <<  "hardware counters are not available, the report contains timers only"  << std::endl;
+                }
+                if( config.enable_memory_counters ) {
+                        run_report::enable_memory_counters();
+                }
+        }
+
         timer_x t;
         graph_access C;
+        run_report::begin_phase("io");
         graph_io::readGraphWeighted(C, graph_filename);
+        run_report::end_phase();
         std::cout << "io time: " << t.elapsed()  << std::endl;
 
         forall_nodes(C, node) {
@@ -88,24 +112,88 @@ int main(int argn, char **argv) {
                 exit(0);
         }
 
-        std::cout <<  "now computing mapping"  << std::endl;
         std::vector< NodeID > perm_rank(config.k);
+        std::vector< NodeID > changed_nodes;
+        bool remap = config.previous_mapping != "";
+        if( remap ) {
+                perm_rank.clear();
+                graph_io::readMapping(perm_rank, config.previous_mapping);
+                if( perm_rank.size() != C.number_of_nodes() ) {
+                        std::cout <<  "The number of nodes of the model does not match size of the previous mapping."  << std::endl;
+                        exit(0);
+                }
+                if( !is_permutation( perm_rank, config.k ) ) {
+                        std::cout <<  "The previous mapping is not a permutation of the PEs 0.." <<  config.k-1 << "."  << std::endl;
+                        exit(0);
+                }
+
+                if( config.previous_model != "" ) {
+                        graph_access old_C;
+                        graph_io::readGraphWeighted(old_C, config.previous_model);
+                        if( old_C.number_of_nodes() != C.number_of_nodes() ) {
+                                std::cout <<  "The number of nodes of the previous model does not match the model."  << std::endl;
+                                exit(0);
+                        }
+                        mapping_algorithms ma;
+                        ma.compute_changed_nodes( old_C, C, changed_nodes);
+                } else {
+                        forall_nodes(C, node) {
+                                changed_nodes.push_back(node);
+                        } endfor
+                }
+        }
+
+        bool resume = false;
+        if( !remap && config.resume_from_checkpoint ) {
+                std::ifstream checkpoint(config.checkpoint_filename.c_str());
+                if( config.checkpoint_filename != "" && checkpoint ) {
+                        perm_rank.clear();
+                        graph_io::readMapping(perm_rank, config.checkpoint_filename);
+                        if( perm_rank.size() != C.number_of_nodes() ) {
+                                std::cout <<  "The number of nodes of the model does not match size of the checkpoint."  << std::endl;
+                                exit(0);
+                        }
+                        if( !is_permutation( perm_rank, config.k ) ) {
+                                std::cout <<  "The checkpoint is not a permutation of the PEs 0.." <<  config.k-1 << "."  << std::endl;
+                                exit(0);
+                        }
+                        resume = true;
+                } else {
+                        std::cout <<  "no checkpoint found, constructing a mapping"  << std::endl;
+                }
+        }
+
+        std::cout <<  "now computing mapping"  << std::endl;
 
         t.restart();
         quality_metrics qm;
+        qm.set_num_threads(config.num_threads);
         mapping_algorithms ma;
 
-        EdgeWeight qap = 0;
+        long long qap = 0;
+        bool success  = true;
         if( config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
                 normal_matrix D(config.k, config.k);
-                ma.construct_a_mapping(config, C, D, perm_rank);
+                run_report::begin_phase("mapping");
+                if( remap )       success = ma.remap_a_mapping(config, C, D, perm_rank, changed_nodes);
+                else if( resume ) success = ma.resume_a_mapping(config, C, D, perm_rank);
+                else              success = ma.construct_a_mapping(config, C, D, perm_rank);
+                run_report::end_phase();
+                if( !success ) exit(0);
                 std::cout <<  "time spent for mapping " << t.elapsed()  << std::endl;
+                run_report::begin_phase("verification");
                 qap = qm.total_qap(C, D, perm_rank );
         } else {
                 online_distance_matrix D(config.k, config.k);
                 D.setPartitionConfig(config);
-                ma.construct_a_mapping(config, C, D, perm_rank);
+                run_report::begin_phase("mapping");
+                if( remap )       success = ma.remap_a_mapping(config, C, D, perm_rank, changed_nodes);
+                else if( resume ) success = ma.resume_a_mapping(config, C, D, perm_rank);
+                else              success = ma.construct_a_mapping(config, C, D, perm_rank);
+                run_report::end_phase();
+                if( !success ) exit(0);
                 std::cout <<  "time spent for mapping " << t.elapsed()  << std::endl;
+                run_report::begin_phase("verification");
                 qap = qm.total_qap(C, D, perm_rank );
         }
         // solution check 
@@ -120,7 +208,12 @@ int main(int argn, char **argv) {
                 }
         }
         std::cout <<  "a permutation"  << std::endl;
+        run_report::end_phase();
         std::cout <<  "quadratic assignment objective J(C,D,Pi') = " << qap << std::endl;
+        if( config.qap_lower_bound > 0 ) {
+                std::cout <<  "lower bound " <<  config.qap_lower_bound 
+                          <<  ", gap " <<  qap_lower_bound::gap( qap, config.qap_lower_bound ) << "%" << std::endl;
+        }
         std::cout <<  "writing to mapping to disk"  << std::endl;
 
         std::stringstream filename;
@@ -130,7 +223,15 @@ int main(int argn, char **argv) {
                 filename << config.filename_output;
         }
 
+        run_report::begin_phase("output");
         graph_io::writeVector( perm_rank, filename.str());
+        run_report::end_phase();
+
+        run_report::set_value("objective", qap);
+        run_report::set_value("lower_bound", config.qap_lower_bound);
+        if( config.report_filename != "" && !run_report::write( config.report_filename, "viem" ) ) {
+                std::cout <<  "could not write report to " <<  config.report_filename  << std::endl;
+        }
         // ******************************* done mapping *****************************************       
 
         ofs.close();
@@ -0,0 +1,232 @@
+/******************************************************************************
+ * viem_batch.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment 
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz 
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <argtable2.h>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <omp.h>
+#include <regex.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h> 
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/normal_matrix.h"
+#include "data_structure/matrix/online_distance_matrix.h"
+#include "graph_io.h"
+#include "macros_assertions.h"
+#include "parse_parameters.h"
+#include "partition/partition_config.h"
+#include "mapping/construct_distance_matrix.h"
+#include "mapping/mapping_algorithms.h"
+#include "null_buffer.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "run_report.h"
+#include "timer.h"
+
+struct batch_job {
+        std::string model_filename;
+        std::string output_filename;
+        NodeID number_of_nodes;
+        EdgeID number_of_edges;
+        long long qap;
+        double time;
+        bool success;
+        std::string failure; // reason if the job did not succeed
+};
+
+// maps all models listed in the input file onto the same system, the distance
+// matrix is constructed only once. every line of the input file contains the
+// path of a model and optionally the output file (default: <model>.permutation).
+int main(int argn, char **argv) {
+
+        PartitionConfig config;
+        std::string batch_filename;
+
+        bool is_graph_weighted = false;
+        bool suppress_output   = false;
+        bool recursive         = false;
+
+        int ret_code = parse_parameters(argn, argv, 
+                        config, 
+                        batch_filename, 
+                        is_graph_weighted, 
+                        suppress_output, recursive); 
+
+        if(ret_code) {
+                return 0;
+        }
+
+        // every model starts from scratch, there is no previous mapping or checkpoint per model
+        if( config.previous_mapping != "" || config.previous_model != "" || config.resume_from_checkpoint ) {
+                std::cout <<  "--previous_mapping, --previous_model and --resume are not supported by viem_batch."  << std::endl;
+                exit(0);
+        }
+
+        std::streambuf* backup = std::cout.rdbuf();
+        std::ofstream ofs;
+        ofs.open("/dev/null");
+        if(suppress_output) {
+                std::cout.rdbuf(ofs.rdbuf()); 
+        }
+
+        if( config.report_filename != "" ) {
+                run_report::enable();
+                if( config.enable_perf_counters && !run_report::enable_perf_counters() ) {
+                        std::cout <<  "hardware counters are not available, the report contains timers only"  << std::endl;
+                }
+                if( config.enable_memory_counters ) {
+                        run_report::enable_memory_counters();
+                }
+        }
+
+        std::vector< batch_job > jobs;
+        std::ifstream in(batch_filename.c_str());
+        if (!in) {
+                std::cerr << "Error opening " << batch_filename << std::endl;
+                return 1;
+        }
+
+        std::string line;
+        while( std::getline(in, line) ) {
+                if( line.size() == 0 || line[0] == '%' ) continue;
+
+                std::stringstream ss(line);
+                batch_job job;
+                if( !(ss >> job.model_filename) ) continue;
+                if( !(ss >> job.output_filename) ) {
+                        job.output_filename = job.model_filename + ".permutation";
+                }
+                job.number_of_nodes = 0;
+                job.number_of_edges = 0;
+                job.qap             = 0;
+                job.time            = 0;
+                job.success         = false;
+                job.failure         = "";
+                jobs.push_back(job);
+        }
+        in.close();
+
+        std::cout <<  "batch has " <<  jobs.size() <<  " models, system has " <<  config.k << " entities."  << std::endl;
+
+        timer_x t;
+        matrix* D = NULL;
+        if( config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
+                D = new normal_matrix(config.k, config.k);
+        } else {
+                online_distance_matrix* online_D = new online_distance_matrix(config.k, config.k);
+                online_D->setPartitionConfig(config);
+                D = online_D;
+        }
+        construct_distance_matrix cdm;
+        run_report::begin_phase("distance_matrix");
+        if( !cdm.construct_matrix( config, *D ) ) exit(0);
+        run_report::end_phase();
+        std::cout <<  "distance matrix construction took " <<  t.elapsed()  << std::endl;
+
+        // the output of the workers would interleave
+        null_buffer null_buf;
+        std::streambuf* batch_backup = std::cout.rdbuf();
+        std::cout.rdbuf(&null_buf); 
+
+        t.restart();
+        run_report::begin_phase("mapping");
+        #pragma omp parallel num_threads(std::max(1, config.num_threads))
+        {
+                // one object per thread, its local search memory is reused for all models of the thread
+                mapping_algorithms ma;
+                quality_metrics qm;
+
+                #pragma omp for schedule(dynamic)
+                for( unsigned i = 0; i < jobs.size(); i++) {
+                        batch_job & job = jobs[i];
+                        timer_x job_t;
+
+                        PartitionConfig job_config = config;
+                        random_functions::setSeed(job_config.seed);
+                        if( config.trace_filename != "" ) {
+                                job_config.trace_filename = job.output_filename + ".trace";
+                        }
+                        if( config.checkpoint_filename != "" ) {
+                                job_config.checkpoint_filename = job.output_filename + ".checkpoint";
+                        }
+
+                        // a malformed model must not end the batch
+                        graph_access C;
+                        if( graph_io::readGraphWeighted(C, job.model_filename, job.failure) != 0 ) {
+                                continue;
+                        }
+                        forall_nodes(C, node) {
+                                C.setNodeWeight(node, 1);
+                        } endfor
+
+                        job.number_of_nodes = C.number_of_nodes();
+                        job.number_of_edges = C.number_of_edges();
+                        if( C.number_of_nodes() != job_config.k ) {
+                                job.failure = "model does not match specified system entities";
+                                continue;
+                        }
+
+                        std::vector< NodeID > perm_rank(job_config.k);
+                        if( !ma.compute_mapping( job_config, C, *D, perm_rank) ) {
+                                job.failure = "objective function mismatch, the model is not symmetric";
+                                continue;
+                        }
+                        job.qap = qm.total_qap(C, *D, perm_rank);
+
+                        graph_io::writeVector( perm_rank, job.output_filename);
+                        job.time    = job_t.elapsed();
+                        job.success = true;
+                }
+        }
+        run_report::end_phase();
+        double total_time = t.elapsed();
+        std::cout.rdbuf(batch_backup);
+
+        delete D;
+
+        std::cout <<  std::left << std::setw(40) << "model" 
+                  <<  std::right << std::setw(10) << "n" 
+                  <<  std::setw(12) << "m" 
+                  <<  std::setw(16) << "J(C,D,Pi)" 
+                  <<  std::setw(12) << "time" << std::endl;
+        for( unsigned i = 0; i < jobs.size(); i++) {
+                batch_job & job = jobs[i];
+                std::cout <<  std::left << std::setw(40) << job.model_filename 
+                          <<  std::right << std::setw(10) << job.number_of_nodes 
+                          <<  std::setw(12) << job.number_of_edges;
+                if( job.success ) {
+                        std::cout <<  std::setw(16) << job.qap <<  std::setw(12) << job.time << std::endl;
+                } else {
+                        std::cout <<  "  " <<  job.failure << std::endl;
+                }
+        }
+        std::cout <<  "time spent for batch " << total_time  << std::endl;
+
+        if( config.report_filename != "" && !run_report::write( config.report_filename, "viem_batch" ) ) {
+                std::cout <<  "could not write report to " <<  config.report_filename  << std::endl;
+        }
+
+        ofs.close();
+        std::cout.rdbuf(backup);
+}
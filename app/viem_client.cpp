@@ -0,0 +1,142 @@
+/******************************************************************************
+ * viem_client.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment 
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz 
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <argtable2.h>
+#include <iostream>
+#include <math.h>
+#include <regex.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h> 
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "data_structure/graph_access.h"
+#include "graph_io.h"
+#include "mapping_service.h"
+#include "parse_parameters.h"
+#include "partition/partition_config.h"
+#include "timer.h"
+
+// sends a model to a running viem_server and writes the returned mapping
+int main(int argn, char **argv) {
+
+        PartitionConfig config;
+        std::string graph_filename;
+
+        bool is_graph_weighted = false;
+        bool suppress_output   = false;
+        bool recursive         = false;
+
+        int ret_code = parse_parameters(argn, argv, 
+                        config, 
+                        graph_filename, 
+                        is_graph_weighted, 
+                        suppress_output, recursive); 
+
+        if(ret_code) {
+                return 0;
+        }
+
+        graph_access C;
+        graph_io::readGraphWeighted(C, graph_filename);
+
+        timer_x t;
+        service_request_header header;
+        header.magic           = VIEM_SERVICE_MAGIC;
+        header.seed            = config.seed;
+        header.hierarchy_depth = config.group_sizes.size();
+        header.n               = C.number_of_nodes();
+        header.m               = C.number_of_edges();
+        switch( config.preconfiguration_mapping ) {
+                case PRE_CONFIG_MAPPING_FAST:
+                        header.mode_mapping = VIEM_MAPMODE_FAST;
+                        break;
+                case PRE_CONFIG_MAPPING_STRONG:
+                        header.mode_mapping = VIEM_MAPMODE_STRONG;
+                        break;
+                default:
+                        header.mode_mapping = VIEM_MAPMODE_ECO;
+        }
+
+        std::vector< int > xadj(C.number_of_nodes()+1), adjncy(C.number_of_edges()), adjcwgt(C.number_of_edges());
+        forall_nodes(C, node) {
+                xadj[node] = C.get_first_edge(node);
+                forall_out_edges(C, e, node) {
+                        adjncy[e]  = C.getEdgeTarget(e);
+                        adjcwgt[e] = C.getEdgeWeight(e);
+                } endfor
+        } endfor
+        xadj[C.number_of_nodes()] = C.number_of_edges();
+
+        struct sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, config.socket_filename.c_str(), sizeof(address.sun_path)-1);
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if( fd < 0 || connect(fd, (struct sockaddr*) &address, sizeof(address)) < 0 ) {
+                perror("could not connect to server");
+                return 1;
+        }
+
+        bool success = service_write(fd, &header, sizeof(header))
+                    && service_write(fd, &config.group_sizes[0], config.group_sizes.size()*sizeof(int))
+                    && service_write(fd, &config.distances[0], config.distances.size()*sizeof(int))
+                    && service_write(fd, &xadj[0], xadj.size()*sizeof(int));
+        if( success && header.m > 0 ) {
+                success = service_write(fd, &adjncy[0], adjncy.size()*sizeof(int))
+                       && service_write(fd, &adjcwgt[0], adjcwgt.size()*sizeof(int));
+        }
+
+        service_response_header response;
+        success = success && service_read(fd, &response, sizeof(response));
+        if( !success ) {
+                std::cout <<  "connection to server failed"  << std::endl;
+                close(fd);
+                return 1;
+        }
+        if( response.status != VIEM_OK ) {
+                std::cout <<  "server rejected the request (error " <<  response.status << ")" << std::endl;
+                close(fd);
+                return 1;
+        }
+
+        std::vector< int > perm(response.n);
+        if( !service_read(fd, &perm[0], perm.size()*sizeof(int)) ) {
+                std::cout <<  "connection to server failed"  << std::endl;
+                close(fd);
+                return 1;
+        }
+        close(fd);
+
+        std::cout <<  "request took " <<  t.elapsed()  << std::endl;
+        std::cout <<  "quadratic assignment objective J(C,D,Pi') = " << response.qap << std::endl;
+
+        std::vector< NodeID > perm_rank(perm.begin(), perm.end());
+        std::stringstream filename;
+        if(!config.filename_output.compare("")) {
+                filename << "permutation";
+        } else {
+                filename << config.filename_output;
+        }
+        graph_io::writeVector( perm_rank, filename.str());
+}
@@ -0,0 +1,275 @@
+/******************************************************************************
+ * viem_server.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment 
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz 
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <argtable2.h>
+#include <iostream>
+#include <math.h>
+#include <list>
+#include <memory>
+#include <omp.h>
+#include <signal.h>
+#include <regex.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h> 
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/normal_matrix.h"
+#include "data_structure/matrix/online_distance_matrix.h"
+#include "mapping/construct_distance_matrix.h"
+#include "mapping/mapping_algorithms.h"
+#include "mapping_service.h"
+#include "null_buffer.h"
+#include "parse_parameters.h"
+#include "partition/partition_config.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "timer.h"
+#include "viem_graph_check.h"
+
+// above this number of PEs the distance matrix is not stored explicitly
+#define SERVICE_MAX_STORED_DISTANCE_MATRIX 16384
+// number of distance matrices that are kept 
+#define SERVICE_DISTANCE_CACHE_SIZE 8
+// larger requests are rejected before anything is allocated
+#define SERVICE_MAX_NODES           (1 << 24)
+#define SERVICE_MAX_EDGES           (1 << 26)
+#define SERVICE_MAX_HIERARCHY_DEPTH 64
+
+struct cached_distances {
+        std::vector< int > group_sizes;
+        std::vector< int > distances;
+        std::shared_ptr< matrix > D;
+};
+
+// least recently used system first, shared by all workers 
+static std::list< cached_distances > distance_cache;
+
+// returns the distance matrix of the system in config, constructs it if it is not cached.
+// a matrix that is evicted stays alive as long as a worker uses it
+static std::shared_ptr< matrix > get_distances( PartitionConfig & config, bool & cache_hit ) {
+        std::shared_ptr< matrix > D;
+        #pragma omp critical (distance_cache)
+        {
+                cache_hit = false;
+                for( std::list< cached_distances >::iterator it = distance_cache.begin(); it != distance_cache.end(); it++) {
+                        if( it->group_sizes == config.group_sizes && it->distances == config.distances ) {
+                                distance_cache.splice(distance_cache.end(), distance_cache, it);
+                                cache_hit = true;
+                                break;
+                        }
+                }
+
+                if( !cache_hit ) {
+                        cached_distances entry;
+                        entry.group_sizes = config.group_sizes;
+                        entry.distances   = config.distances;
+                        if( config.distance_construction_algorithm == DIST_CONST_HIERARCHY ) {
+                                entry.D = std::shared_ptr< matrix >(new normal_matrix(config.k, config.k));
+                        } else {
+                                online_distance_matrix* online_D = new online_distance_matrix(config.k, config.k);
+                                online_D->setPartitionConfig(config);
+                                entry.D = std::shared_ptr< matrix >(online_D);
+                        }
+                        construct_distance_matrix cdm;
+                        cdm.construct_matrix( config, *entry.D );
+
+                        if( distance_cache.size() == SERVICE_DISTANCE_CACHE_SIZE ) {
+                                distance_cache.pop_front();
+                        }
+                        distance_cache.push_back(entry);
+                }
+                D = distance_cache.back().D;
+        }
+        return D;
+}
+
+static bool valid_request( service_request_header & header, std::vector< int > & group_sizes, std::vector< int > & distances,
+                           std::vector< int > & xadj, std::vector< int > & adjncy, std::vector< int > & adjcwgt, int & status) {
+        status = VIEM_ERROR_INVALID_SYSTEM;
+        long num_PEs = 1;
+        for( int i = 0; i < header.hierarchy_depth; i++) {
+                if( group_sizes[i] <= 0 || distances[i] < 0 ) return false;
+                num_PEs *= group_sizes[i];
+        }
+        if( num_PEs != header.n ) return false;
+
+        status = VIEM_ERROR_INVALID_GRAPH;
+        if( xadj[header.n] != header.m ) return false;
+        if( !viem_valid_graph( header.n, xadj.data(), adjcwgt.data(), adjncy.data() ) ) return false;
+
+        status = VIEM_OK;
+        return true;
+}
+
+// answers one request, returns false if the connection broke
+static bool handle_request( int fd, PartitionConfig* presets, mapping_algorithms & ma, std::ostream & log) {
+        timer_x t;
+        service_request_header header;
+        service_response_header response;
+        response.status = VIEM_ERROR_INVALID_REQUEST;
+        response.n      = 0;
+        response.qap    = 0;
+
+        if( !service_read(fd, &header, sizeof(header)) ) return false;
+        if( header.magic != VIEM_SERVICE_MAGIC || header.hierarchy_depth <= 0 || header.n <= 0 || header.m < 0 
+            || header.hierarchy_depth > SERVICE_MAX_HIERARCHY_DEPTH || header.n > SERVICE_MAX_NODES 
+            || header.m > SERVICE_MAX_EDGES || header.m > (long)header.n*header.n ) {
+                service_write(fd, &response, sizeof(response));
+                return false; // the rest of the stream cannot be interpreted
+        }
+
+        std::vector< int > group_sizes(header.hierarchy_depth), distances(header.hierarchy_depth);
+        std::vector< int > xadj(header.n+1), adjncy(header.m), adjcwgt(header.m);
+        if( !service_read(fd, &group_sizes[0], group_sizes.size()*sizeof(int)) ) return false;
+        if( !service_read(fd, &distances[0],   distances.size()*sizeof(int)) ) return false;
+        if( !service_read(fd, &xadj[0],        xadj.size()*sizeof(int)) ) return false;
+        if( header.m > 0 ) {
+                if( !service_read(fd, &adjncy[0],  adjncy.size()*sizeof(int)) ) return false;
+                if( !service_read(fd, &adjcwgt[0], adjcwgt.size()*sizeof(int)) ) return false;
+        }
+
+        int status = VIEM_OK;
+        if( !valid_request(header, group_sizes, distances, xadj, adjncy, adjcwgt, status) ) {
+                response.status = status;
+                return service_write(fd, &response, sizeof(response));
+        }
+
+        int mode = header.mode_mapping;
+        if( mode < VIEM_MAPMODE_FAST || mode > VIEM_MAPMODE_STRONG ) mode = VIEM_MAPMODE_ECO;
+
+        PartitionConfig config  = presets[mode];
+        config.seed             = header.seed;
+        config.group_sizes      = group_sizes;
+        config.distances        = distances;
+        config.k                = header.n;
+        config.distance_construction_algorithm = config.k <= SERVICE_MAX_STORED_DISTANCE_MATRIX ? DIST_CONST_HIERARCHY : DIST_CONST_HIERARCHY_ONLINE;
+        random_functions::setSeed(config.seed);
+
+        bool cache_hit = false;
+        std::shared_ptr< matrix > D = get_distances( config, cache_hit );
+
+        graph_access C;
+        std::vector< int > vwgt(header.n, 1);
+        C.build_from_metis_weighted(header.n, &xadj[0], &adjncy[0], &vwgt[0], &adjcwgt[0]);
+
+        std::vector< NodeID > perm_rank(config.k);
+        if( !ma.compute_mapping( config, C, *D, perm_rank) ) {
+                response.status = VIEM_ERROR_MAPPING_FAILED;
+                #pragma omp critical (log)
+                {
+                        log <<  "request n=" <<  header.n <<  " m=" << header.m <<  " failed, objective mismatch" << std::endl;
+                }
+                return service_write(fd, &response, sizeof(response));
+        }
+
+        quality_metrics qm;
+        std::vector< int > perm(perm_rank.begin(), perm_rank.end());
+        response.status = VIEM_OK;
+        response.n      = header.n;
+        response.qap    = qm.total_qap(C, *D, perm_rank);
+
+        bool success = service_write(fd, &response, sizeof(response)) && service_write(fd, &perm[0], perm.size()*sizeof(int));
+
+        #pragma omp critical (log)
+        {
+                log <<  "request n=" <<  header.n <<  " m=" << header.m 
+                    <<  " distances " <<  (cache_hit ? "cached" : "constructed")
+                    <<  " J(C,D,Pi)=" << response.qap <<  " time " << t.elapsed() << std::endl;
+        }
+        return success;
+}
+
+// keeps distance matrices, mapping presets and worker threads between requests.
+// usage: viem_server SOCKET [--num_threads=<int>] [mapping options]
+int main(int argn, char **argv) {
+
+        PartitionConfig config;
+        std::string socket_filename;
+
+        bool is_graph_weighted = false;
+        bool suppress_output   = false;
+        bool recursive         = false;
+
+        int ret_code = parse_parameters(argn, argv, 
+                        config, 
+                        socket_filename, 
+                        is_graph_weighted, 
+                        suppress_output, recursive); 
+
+        if(ret_code) {
+                return 0;
+        }
+
+        // the presets of the mapping modes are set up once
+        PartitionConfig presets[3];
+        presets[VIEM_MAPMODE_FAST]   = config;
+        presets[VIEM_MAPMODE_ECO]    = config;
+        presets[VIEM_MAPMODE_STRONG] = config;
+        presets[VIEM_MAPMODE_FAST].preconfiguration_mapping   = PRE_CONFIG_MAPPING_FAST;
+        presets[VIEM_MAPMODE_ECO].preconfiguration_mapping    = PRE_CONFIG_MAPPING_ECO;
+        presets[VIEM_MAPMODE_STRONG].preconfiguration_mapping = PRE_CONFIG_MAPPING_STRONG;
+
+        struct sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if( socket_filename.size() >= sizeof(address.sun_path) ) {
+                std::cerr <<  "socket path is too long"  << std::endl;
+                return 1;
+        }
+        strcpy(address.sun_path, socket_filename.c_str());
+
+        int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(socket_filename.c_str());
+        if( listen_fd < 0 || bind(listen_fd, (struct sockaddr*) &address, sizeof(address)) < 0 || listen(listen_fd, 64) < 0 ) {
+                perror("could not open socket");
+                return 1;
+        }
+        signal(SIGPIPE, SIG_IGN); // a client that disconnects must not stop the server
+
+        int num_workers = std::max(1, config.num_threads);
+
+        // the output of the workers would interleave, only the request log is written
+        std::streambuf* backup = std::cout.rdbuf();
+        std::ostream log(suppress_output ? NULL : backup);
+        null_buffer null_buf;
+        std::cout.rdbuf(&null_buf); 
+
+        log <<  "listening on " <<  socket_filename <<  " with " <<  num_workers << " workers" << std::endl;
+
+        #pragma omp parallel num_threads(num_workers)
+        {
+                // one object per worker, its local search memory is reused for all requests
+                mapping_algorithms ma;
+                while( true ) {
+                        int fd = accept(listen_fd, NULL, NULL);
+                        if( fd < 0 ) continue;
+
+                        // a connection may carry several requests
+                        while( handle_request(fd, presets, ma, log) );
+                        close(fd);
+                }
+        }
+
+        std::cout.rdbuf(backup);
+}
@@ -13,7 +13,7 @@ if [[ "$unamestr" == "Darwin" ]]; then
 fi
 
 
-for program in viem graphchecker generate_model evaluator; do 
+for program in viem viem_batch viem_server viem_client graphchecker generate_model generate_and_map evaluator bench microbench regression_stats library; do 
 scons program=$program variant=optimized -j $NCORES 
 if [ "$?" -ne "0" ]; then 
         echo "compile error in $program. exiting."
@@ -24,9 +24,18 @@ done
 mkdir deploy
 
 cp ./optimized/viem deploy/
+cp ./optimized/viem_batch deploy/
+cp ./optimized/viem_server deploy/
+cp ./optimized/viem_client deploy/
 cp ./optimized/graphchecker deploy/
 cp ./optimized/generate_model deploy/
+cp ./optimized/generate_and_map deploy/
 cp ./optimized/evaluator deploy/
+cp ./optimized/bench deploy/
+cp ./optimized/microbench deploy/
+cp ./optimized/regression_stats deploy/
+cp ./optimized/libviem.so deploy/
+cp ./interface/viem_interface.h deploy/
 
 rm -rf ./optimized
 rm -rf config.log
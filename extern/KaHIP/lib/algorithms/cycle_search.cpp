@@ -27,7 +27,7 @@
 #include "random_functions.h"
 #include "timer.h"
 
-double cycle_search::total_time = 0;
+thread_local double cycle_search::total_time = 0;
 
 cycle_search::cycle_search() {
 
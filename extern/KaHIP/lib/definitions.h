@@ -182,6 +182,12 @@ typedef enum {
         PRE_CONFIG_MAPPING_STRONG
 } PreConfigMapping;
 
+typedef enum {
+        RELABEL_NONE,
+        RELABEL_RCM,
+        RELABEL_MAPPING
+} RelabelingType;
+
 
 #endif
 
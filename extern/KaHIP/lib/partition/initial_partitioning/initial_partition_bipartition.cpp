@@ -25,6 +25,7 @@
 #include "uncoarsening/refinement/kway_graph_refinement/kway_graph_refinement.h"
 #include "uncoarsening/refinement/mixed_refinement.h"
 #include "graph_partitioner.h"
+#include "tools/null_buffer.h"
 
 initial_partition_bipartition::initial_partition_bipartition() {
 
@@ -58,15 +59,10 @@ void initial_partition_bipartition::initial_partition( const PartitionConfig & c
 	}
 
 
-        std::streambuf* backup = std::cout.rdbuf();
-        std::ofstream ofs;
-        ofs.open("/dev/null");
-        std::cout.rdbuf(ofs.rdbuf()); 
-
-        gp.perform_recursive_partitioning(rec_config, G); 
-
-        ofs.close();
-        std::cout.rdbuf(backup);
+        {
+                silence_output silence;
+                gp.perform_recursive_partitioning(rec_config, G); 
+        }
 
         forall_nodes(G, n) {
                 partition_map[n] =  G.getPartitionIndex(n);
@@ -365,15 +365,67 @@ struct PartitionConfig
 
         int max_recursion_levels_construction; 
 
+        bool enable_hierarchy_partitioning;
+
+        std::string previous_mapping;
+
+        std::string checkpoint_filename;
+
+        double checkpoint_interval;
+
+        bool resume_from_checkpoint;
+
+        double gap_threshold;
+
+        long qap_lower_bound;
+
+        RelabelingType relabeling;
+
+        std::string bench_models;
+
+        std::string bench_construction_algorithms;
+
+        std::string bench_neighborhoods;
+
+        std::string report_filename;
+
+        bool enable_perf_counters;
+
+        bool enable_memory_counters;
+
+        std::string trace_filename;
+
+        unsigned trace_interval;
+
+        std::string socket_filename;
+
+        std::string previous_model;
+
         bool enable_cycle_local_search;
 
         bool enable_group_local_search;
 
+        bool enable_tabu_search;
+
+        bool enable_exact_group_search;
+
+        int exact_group_max_tasks;
+
+        bool enable_evolutionary_mapping;
+
+        unsigned evolutionary_generations;
+
+        int num_islands;
+
+        bool deterministic;
+
         //=======================================
         //===============Shared Mem OMP==========
         //=======================================
         bool enable_omp;
 
+        int num_threads;
+
         void LogDump(FILE *out) const {
         }
 };
@@ -24,7 +24,7 @@
 
 #include "kway_graph_refinement_commons.h"
 
-std::vector<kway_graph_refinement_commons*>* kway_graph_refinement_commons::m_instances = NULL;
+thread_local kway_graph_refinement_commons* kway_graph_refinement_commons::m_instance = NULL;
 
 kway_graph_refinement_commons::kway_graph_refinement_commons() {
 
@@ -37,26 +37,18 @@ kway_graph_refinement_commons::~kway_graph_refinement_commons() {
 kway_graph_refinement_commons* kway_graph_refinement_commons::getInstance( PartitionConfig & config ) {
 
         bool created = false;
-        #pragma omp critical 
-        {
-                if( m_instances == NULL ) {
-                        m_instances = new std::vector< kway_graph_refinement_commons*>(omp_get_max_threads(), reinterpret_cast<kway_graph_refinement_commons*>(NULL));
-                }
-        } 
-
-        int id = omp_get_thread_num();
-        if((*m_instances)[id] == NULL) {
-                (*m_instances)[id] = new kway_graph_refinement_commons();
-                (*m_instances)[id]->init(config);
+        if(m_instance == NULL) {
+                m_instance = new kway_graph_refinement_commons();
+                m_instance->init(config);
                 created = true;
         }
 
         if(created == false) {
-                if(config.k != (*m_instances)[id]->getUnderlyingK()) {
+                if(config.k != m_instance->getUnderlyingK()) {
                         //should be a very rare case 
-                        (*m_instances)[id]->init(config); 
+                        m_instance->init(config); 
                 }
         }
 
-        return  (*m_instances)[id];
+        return  m_instance;
 }
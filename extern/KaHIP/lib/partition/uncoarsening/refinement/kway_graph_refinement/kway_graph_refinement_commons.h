@@ -65,8 +65,9 @@ class kway_graph_refinement_commons  {
                         EdgeWeight local_degree;
                 };
 
-                static 
-                std::vector<kway_graph_refinement_commons*>* m_instances;
+                // one instance per thread, the threads may belong to different (nested) teams
+                static thread_local 
+                kway_graph_refinement_commons*               m_instance;
                 std::vector<round_struct>                    m_local_degrees;
                 unsigned                                     m_round;
 };
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * null_buffer.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment 
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz 
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef NULL_BUFFER_3HZK7WQC
+#define NULL_BUFFER_3HZK7WQC
+
+#include <iostream>
+#include <omp.h>
+#include <streambuf>
+
+// discards everything. it has no state and hence can be used as buffer of 
+// std::cout by several threads at once (unlike a std::ofstream of /dev/null)
+class null_buffer : public std::streambuf {
+protected:
+        int overflow(int c) { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char* s, std::streamsize n) { return n; }
+};
+
+// silences std::cout as long as it lives. swapping the buffer of std::cout is not thread safe,
+// inside of a parallel region nothing is done and the caller has to silence the output
+class silence_output {
+public:
+        silence_output() : m_backup(NULL) {
+                if( !omp_in_parallel() ) {
+                        m_backup = std::cout.rdbuf(&m_null);
+                }
+        }
+
+        ~silence_output() {
+                if( m_backup != NULL ) {
+                        std::cout.rdbuf(m_backup);
+                }
+        }
+
+private:
+        silence_output(const silence_output&);
+        silence_output& operator=(const silence_output&);
+
+        null_buffer m_null;
+        std::streambuf* m_backup;
+};
+
+#endif /* end of include guard: NULL_BUFFER_3HZK7WQC */
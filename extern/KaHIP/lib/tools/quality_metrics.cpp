@@ -23,13 +23,76 @@
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <limits>
+#include <omp.h>
 #include <unordered_map>
 
 #include "quality_metrics.h"
 #include "data_structure/union_find.h"
 
+// sums are accumulated in 64 bit and the loops over the nodes run in parallel (with the
+// threads given by set_num_threads, default 1) if the graph has at least this many 
+// edges. inside of parallel regions the loops run on the calling thread only.
+#define QM_MIN_PARALLEL_EDGES 100000
 
-quality_metrics::quality_metrics() {
+static inline bool run_parallel( graph_access & G, int num_threads ) {
+        return num_threads > 1 && G.number_of_edges() >= QM_MIN_PARALLEL_EDGES && !omp_in_parallel();
+}
+
+// number of blocks other than its own a node is adjacent to, summed up per block.
+// marker[block] is the last node that counted block, so it is never reset
+template< typename Partition >
+static void block_communication_volumes( graph_access & G, PartitionID k, Partition partition, std::vector< long long > & block_volume, int num_threads ) {
+        block_volume.assign(k, 0);
+        NodeID num_nodes = G.number_of_nodes();
+
+        #pragma omp parallel num_threads(num_threads) if(run_parallel(G, num_threads))
+        {
+                std::vector< NodeID > marker(k, std::numeric_limits< NodeID >::max());
+                std::vector< long long > local_volume(k, 0);
+
+                #pragma omp for schedule(guided) nowait
+                for( NodeID node = 0; node < num_nodes; node++) {
+                        PartitionID block = partition(node);
+                        marker[block] = node;
+                        long long num_incident_blocks = 0;
+
+                        forall_out_edges(G, e, node) {
+                                PartitionID target_block = partition(G.getEdgeTarget(e));
+                                if( marker[target_block] != node ) {
+                                        marker[target_block] = node;
+                                        num_incident_blocks++;
+                                }
+                        } endfor
+                        local_volume[block] += num_incident_blocks;
+                }
+
+                #pragma omp critical (quality_metrics)
+                for( PartitionID block = 0; block < k; block++) {
+                        block_volume[block] += local_volume[block];
+                }
+        }
+}
+
+template< typename Partition >
+static long long cut_weight( graph_access & G, Partition partition, int num_threads ) {
+        long long edge_cut = 0;
+        NodeID num_nodes   = G.number_of_nodes();
+
+        #pragma omp parallel for schedule(guided) reduction(+:edge_cut) num_threads(num_threads) if(run_parallel(G, num_threads))
+        for( NodeID n = 0; n < num_nodes; n++) {
+                PartitionID partitionIDSource = partition(n);
+                forall_out_edges(G, e, n) {
+                        if( partitionIDSource != partition(G.getEdgeTarget(e)) ) {
+                                edge_cut += G.getEdgeWeight(e);
+                        }
+                } endfor 
+        }
+        return edge_cut;
+}
+
+
+quality_metrics::quality_metrics() : m_num_threads(1) {
 }
 
 quality_metrics::~quality_metrics () {
@@ -68,40 +131,19 @@ EdgeWeight quality_metrics::diameter(graph_access & G) {
 }
 
 EdgeWeight quality_metrics::edge_cut(graph_access & G) {
-        EdgeWeight edgeCut = 0;
-        forall_nodes(G, n) { 
-                PartitionID partitionIDSource = G.getPartitionIndex(n);
-                forall_out_edges(G, e, n) {
-                        NodeID targetNode = G.getEdgeTarget(e);
-                        PartitionID partitionIDTarget = G.getPartitionIndex(targetNode);
-
-                        if (partitionIDSource != partitionIDTarget) {
-                                edgeCut += G.getEdgeWeight(e);
-                        }
-                } endfor 
-        } endfor
-        return edgeCut/2;
+        return cut_weight( G, [&]( NodeID node ) { return G.getPartitionIndex(node); }, m_num_threads )/2;
 }
 
 EdgeWeight quality_metrics::edge_cut(graph_access & G, int * partition_map) {
-        EdgeWeight edgeCut = 0;
-        forall_nodes(G, n) { 
-                PartitionID partitionIDSource = partition_map[n];
-                forall_out_edges(G, e, n) {
-                        NodeID targetNode = G.getEdgeTarget(e);
-                        PartitionID partitionIDTarget = partition_map[targetNode];
-
-                        if (partitionIDSource != partitionIDTarget) {
-                                edgeCut += G.getEdgeWeight(e);
-                        }
-                } endfor 
-        } endfor
-        return edgeCut/2;
+        return cut_weight( G, [&]( NodeID node ) { return (PartitionID) partition_map[node]; }, m_num_threads )/2;
 }
 
 EdgeWeight quality_metrics::edge_cut(graph_access & G, PartitionID lhs, PartitionID rhs) {
-        EdgeWeight edgeCut = 0;
-        forall_nodes(G, n) { 
+        long long edgeCut = 0;
+        NodeID num_nodes  = G.number_of_nodes();
+
+        #pragma omp parallel for schedule(guided) reduction(+:edgeCut) num_threads(m_num_threads) if(run_parallel(G, m_num_threads))
+        for( NodeID n = 0; n < num_nodes; n++) {
                 PartitionID partitionIDSource = G.getPartitionIndex(n);
                 if(partitionIDSource != lhs) continue;
                 forall_out_edges(G, e, n) {
@@ -112,7 +154,7 @@ EdgeWeight quality_metrics::edge_cut(graph_access & G, PartitionID lhs, Partitio
                                 edgeCut += G.getEdgeWeight(e);
                         }
                 } endfor 
-        } endfor
+        }
         return edgeCut;
 }
 
@@ -158,103 +200,37 @@ EdgeWeight quality_metrics::edge_cut_connected(graph_access & G, int * partition
 
 
 EdgeWeight quality_metrics::max_communication_volume(graph_access & G, int * partition_map) {
-        std::vector<EdgeWeight> block_volume(G.get_partition_count(),0);
-        forall_nodes(G, node) {
-                PartitionID block = partition_map[node];
-                std::vector<bool> block_incident(G.get_partition_count(), false);
-                block_incident[block] = true;
-
-                int num_incident_blocks = 0;
-
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        PartitionID target_block = partition_map[target];
-                        if(!block_incident[target_block]) {
-                                block_incident[target_block] = true;
-                                num_incident_blocks++;
-                        }
-                } endfor
-                block_volume[block] += num_incident_blocks;
-        } endfor
-
-        EdgeWeight max_comm_volume = *(std::max_element(block_volume.begin(), block_volume.end()));
-        return max_comm_volume;
+        std::vector< long long > block_volume;
+        block_communication_volumes( G, G.get_partition_count(), [&]( NodeID node ) { return (PartitionID) partition_map[node]; }, block_volume, m_num_threads );
+        return *(std::max_element(block_volume.begin(), block_volume.end()));
 }
 
 EdgeWeight quality_metrics::min_communication_volume(graph_access & G) {
-        std::vector<EdgeWeight> block_volume(G.get_partition_count(),0);
-        forall_nodes(G, node) {
-                PartitionID block = G.getPartitionIndex(node);
-                std::vector<bool> block_incident(G.get_partition_count(), false);
-                block_incident[block] = true;
-                int num_incident_blocks = 0;
-
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        PartitionID target_block = G.getPartitionIndex(target);
-                        if(!block_incident[target_block]) {
-                                block_incident[target_block] = true;
-                                num_incident_blocks++;
-                        }
-                } endfor
-                block_volume[block] += num_incident_blocks;
-        } endfor
-
-        EdgeWeight min_comm_volume = *(std::min_element(block_volume.begin(), block_volume.end()));
-        return min_comm_volume;
+        std::vector< long long > block_volume;
+        block_communication_volumes( G, G.get_partition_count(), [&]( NodeID node ) { return G.getPartitionIndex(node); }, block_volume, m_num_threads );
+        return *(std::min_element(block_volume.begin(), block_volume.end()));
 }
 
 EdgeWeight quality_metrics::max_communication_volume(graph_access & G) {
-        std::vector<EdgeWeight> block_volume(G.get_partition_count(),0);
-        forall_nodes(G, node) {
-                PartitionID block = G.getPartitionIndex(node);
-                std::vector<bool> block_incident(G.get_partition_count(), false);
-                block_incident[block] = true;
-                int num_incident_blocks = 0;
-
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        PartitionID target_block = G.getPartitionIndex(target);
-                        if(!block_incident[target_block]) {
-                                block_incident[target_block] = true;
-                                num_incident_blocks++;
-                        }
-                } endfor
-                block_volume[block] += num_incident_blocks;
-        } endfor
-
-        EdgeWeight max_comm_volume = *(std::max_element(block_volume.begin(), block_volume.end()));
-        return max_comm_volume;
+        std::vector< long long > block_volume;
+        block_communication_volumes( G, G.get_partition_count(), [&]( NodeID node ) { return G.getPartitionIndex(node); }, block_volume, m_num_threads );
+        return *(std::max_element(block_volume.begin(), block_volume.end()));
 }
 
 EdgeWeight quality_metrics::total_communication_volume(graph_access & G) {
-        std::vector<EdgeWeight> block_volume(G.get_partition_count(),0);
-        forall_nodes(G, node) {
-                PartitionID block = G.getPartitionIndex(node);
-                std::vector<bool> block_incident(G.get_partition_count(), false);
-                block_incident[block] = true;
-                int num_incident_blocks = 0;
-
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        PartitionID target_block = G.getPartitionIndex(target);
-                        if(!block_incident[target_block]) {
-                                block_incident[target_block] = true;
-                                num_incident_blocks++;
-                        }
-                } endfor
-                block_volume[block] += num_incident_blocks;
-        } endfor
-
-        EdgeWeight total_comm_volume = std::accumulate(block_volume.begin(), block_volume.end(),0);
-        return total_comm_volume;
+        std::vector< long long > block_volume;
+        block_communication_volumes( G, G.get_partition_count(), [&]( NodeID node ) { return G.getPartitionIndex(node); }, block_volume, m_num_threads );
+        return std::accumulate(block_volume.begin(), block_volume.end(), 0LL);
 }
 
 
 
 int quality_metrics::boundary_nodes(graph_access& G) {
         int no_of_boundary_nodes = 0;
-        forall_nodes(G, n) { 
+        NodeID num_nodes         = G.number_of_nodes();
+
+        #pragma omp parallel for schedule(guided) reduction(+:no_of_boundary_nodes) num_threads(m_num_threads) if(run_parallel(G, m_num_threads))
+        for( NodeID n = 0; n < num_nodes; n++) {
                 PartitionID partitionIDSource = G.getPartitionIndex(n);
 
                 forall_out_edges(G, e, n) {
@@ -266,21 +242,33 @@ int quality_metrics::boundary_nodes(graph_access& G) {
                                 break; 
                         }
                 } endfor 
-        }       endfor
+        }
         return no_of_boundary_nodes;
 }
 
 
 double quality_metrics::balance(graph_access& G) {
-        std::vector<PartitionID> part_weights(G.get_partition_count(), 0);
+        PartitionID k = G.get_partition_count();
+        std::vector< long long > part_weights(k, 0);
+        NodeID num_nodes = G.number_of_nodes();
 
-        double overallWeight = 0;
+        long long overallWeight = 0;
 
-        forall_nodes(G, n) {
-                PartitionID curPartition = G.getPartitionIndex(n);
-                part_weights[curPartition] += G.getNodeWeight(n);
-                overallWeight += G.getNodeWeight(n);
-        } endfor
+        #pragma omp parallel num_threads(m_num_threads) if(run_parallel(G, m_num_threads))
+        {
+                std::vector< long long > local_weights(k, 0);
+
+                #pragma omp for reduction(+:overallWeight) nowait
+                for( NodeID n = 0; n < num_nodes; n++) {
+                        local_weights[G.getPartitionIndex(n)] += G.getNodeWeight(n);
+                        overallWeight += G.getNodeWeight(n);
+                }
+
+                #pragma omp critical (quality_metrics)
+                for( PartitionID p = 0; p < k; p++) {
+                        part_weights[p] += local_weights[p];
+                }
+        }
 
         double balance_part_weight = ceil(overallWeight / (double)G.get_partition_count());
         double cur_max             = -1;
@@ -306,30 +294,98 @@ EdgeWeight quality_metrics::objective(const PartitionConfig & config, graph_acce
         }
 }
 
-NodeWeight quality_metrics::total_qap(graph_access & C, matrix & D, std::vector< NodeID > & rank_assign) {
-        NodeWeight total_volume = 0;
-        forall_nodes(C, node) {
+long long quality_metrics::total_qap(graph_access & C, matrix & D, std::vector< NodeID > & rank_assign) {
+        long long total_volume = 0;
+        NodeID num_nodes       = C.number_of_nodes();
+
+        #pragma omp parallel for schedule(guided) reduction(+:total_volume) num_threads(m_num_threads) if(run_parallel(C, m_num_threads))
+        for( NodeID node = 0; node < num_nodes; node++) {
+                NodeID perm_rank_node = rank_assign[node];
                 forall_out_edges(C, e, node) {
                         NodeID target           = C.getEdgeTarget(e);
-                        NodeWeight comm_vol     = C.getEdgeWeight(e);
-                        NodeID perm_rank_node   = rank_assign[node];
+                        long long comm_vol      = C.getEdgeWeight(e);
                         NodeID perm_rank_target = rank_assign[target];
-                        NodeWeight cur_vol      = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
-                        total_volume           += cur_vol; 
+                        total_volume           += comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
                 } endfor
-        } endfor
+        }
         return total_volume;
 }
 
-NodeWeight quality_metrics::total_qap(matrix & C, matrix & D, std::vector< NodeID > & rank_assign) {
-        NodeWeight total_volume = 0;
-        for( unsigned int i = 0; i < C.get_x_dim(); i++) {
+long long quality_metrics::total_qap(matrix & C, matrix & D, std::vector< NodeID > & rank_assign) {
+        long long total_volume = 0;
+        int dim_x = C.get_x_dim();
+
+        #pragma omp parallel for schedule(guided) reduction(+:total_volume) num_threads(m_num_threads) if(m_num_threads > 1 && dim_x >= 1024 && !omp_in_parallel())
+        for( int i = 0; i < dim_x; i++) {
+                NodeID perm_rank_node = rank_assign[i];
                 for( unsigned int j = 0; j < C.get_y_dim(); j++) {
-                        NodeID perm_rank_node      = rank_assign[i];
                         NodeID perm_rank_target    = rank_assign[j];
-                        total_volume += C.get_xy(i,j)*D.get_xy(perm_rank_node, perm_rank_target);
+                        total_volume += (long long) C.get_xy(i,j)*D.get_xy(perm_rank_node, perm_rank_target);
                 }
         }
         return total_volume;
 }
 
+void quality_metrics::compute_all(graph_access & G, partition_metrics & metrics, matrix * D, std::vector< NodeID > * rank_assign) {
+        PartitionID k    = G.get_partition_count();
+        NodeID num_nodes = G.number_of_nodes();
+        bool with_qap    = D != NULL && rank_assign != NULL;
+
+        std::vector< long long > block_volume(k, 0);
+        std::vector< long long > part_weights(k, 0);
+        long long edge_cut = 0, total_weight = 0, qap = 0;
+        long long boundary_nodes = 0;
+
+        #pragma omp parallel num_threads(m_num_threads) if(run_parallel(G, m_num_threads))
+        {
+                std::vector< NodeID > marker(k, std::numeric_limits< NodeID >::max());
+                std::vector< long long > local_volume(k, 0);
+                std::vector< long long > local_weights(k, 0);
+
+                #pragma omp for schedule(guided) reduction(+:edge_cut,total_weight,qap,boundary_nodes) nowait
+                for( NodeID node = 0; node < num_nodes; node++) {
+                        PartitionID block = G.getPartitionIndex(node);
+                        marker[block] = node;
+                        local_weights[block] += G.getNodeWeight(node);
+                        total_weight         += G.getNodeWeight(node);
+
+                        long long num_incident_blocks = 0;
+                        long long node_cut            = 0;
+                        forall_out_edges(G, e, node) {
+                                NodeID target             = G.getEdgeTarget(e);
+                                PartitionID target_block  = G.getPartitionIndex(target);
+                                if( target_block != block ) {
+                                        node_cut += G.getEdgeWeight(e);
+                                        if( marker[target_block] != node ) {
+                                                marker[target_block] = node;
+                                                num_incident_blocks++;
+                                        }
+                                }
+                                if( with_qap ) {
+                                        qap += (long long) G.getEdgeWeight(e)*D->get_xy((*rank_assign)[node], (*rank_assign)[target]);
+                                }
+                        } endfor
+                        local_volume[block] += num_incident_blocks;
+                        edge_cut            += node_cut;
+                        if( node_cut > 0 ) boundary_nodes++;
+                }
+
+                #pragma omp critical (quality_metrics)
+                for( PartitionID p = 0; p < k; p++) {
+                        block_volume[p] += local_volume[p];
+                        part_weights[p] += local_weights[p];
+                }
+        }
+
+        metrics.edge_cut                   = edge_cut/2;
+        metrics.boundary_nodes             = boundary_nodes;
+        metrics.total_communication_volume = std::accumulate(block_volume.begin(), block_volume.end(), 0LL);
+        metrics.max_communication_volume   = k > 0 ? *(std::max_element(block_volume.begin(), block_volume.end())) : 0;
+        metrics.min_communication_volume   = k > 0 ? *(std::min_element(block_volume.begin(), block_volume.end())) : 0;
+        metrics.qap                        = qap;
+
+        double balance_part_weight = ceil(total_weight / (double) k);
+        long long max_weight       = k > 0 ? *(std::max_element(part_weights.begin(), part_weights.end())) : 0;
+        metrics.balance            = max_weight / balance_part_weight;
+}
+
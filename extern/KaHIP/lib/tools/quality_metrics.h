@@ -24,15 +24,32 @@
 #ifndef QUALITY_METRICS_10HC2I5M
 #define QUALITY_METRICS_10HC2I5M
 
+#include <algorithm>
+
 #include "data_structure/graph_access.h"
 #include "data_structure/matrix/matrix.h"
 #include "partition_config.h"
 
+// metrics of a partitioned graph (blocks given by the partition index), the qap objective 
+// only if a distance matrix and a mapping were given
+struct partition_metrics {
+        long long edge_cut;
+        long long boundary_nodes;
+        long long total_communication_volume;
+        long long max_communication_volume;
+        long long min_communication_volume;
+        double balance;
+        long long qap;
+};
+
 class quality_metrics {
 public:
         quality_metrics();
         virtual ~quality_metrics ();
 
+        // threads used for graphs with many edges, the default is a single thread
+        void set_num_threads( int num_threads ) { m_num_threads = std::max(1, num_threads); }
+
         EdgeWeight diameter(graph_access & G);
         EdgeWeight edge_cut(graph_access & G);
         EdgeWeight edge_cut(graph_access & G, int * partition_map); 
@@ -46,8 +63,14 @@ public:
         int boundary_nodes(graph_access & G);
         double balance(graph_access & G);
 
-        NodeWeight total_qap(graph_access & C, matrix & D, std::vector< NodeID > & rank_assign);
-        NodeWeight total_qap(matrix & C, matrix & D, std::vector< NodeID > & rank_assign);
+        long long total_qap(graph_access & C, matrix & D, std::vector< NodeID > & rank_assign);
+        long long total_qap(matrix & C, matrix & D, std::vector< NodeID > & rank_assign);
+
+        // all of the above (except the diameter) in a single pass over the edges
+        void compute_all(graph_access & G, partition_metrics & metrics, matrix * D = NULL, std::vector< NodeID > * rank_assign = NULL);
+
+private:
+        int m_num_threads;
 };
 
 #endif /* end of include guard: QUALITY_METRICS_10HC2I5M */
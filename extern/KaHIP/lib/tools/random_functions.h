@@ -25,12 +25,98 @@
 
 #include <iostream>
 #include <random>
+#include <stdint.h>
 #include <vector>
 
 #include "definitions.h"
 #include "partition_config.h"
 
-typedef std::mt19937 MersenneTwister;
+// xoshiro256** (blackman and vigna) seeded by splitmix64. 48 bytes of state instead of 
+// the 2.5kb of std::mt19937 and a few cycles per number, satisfies UniformRandomBitGenerator
+class xoshiro256 {
+        public:
+                typedef uint64_t result_type;
+
+                xoshiro256( uint64_t seed_value = 0 ) {
+                        seed(seed_value);
+                }
+
+                void seed( uint64_t seed_value ) {
+                        for( int i = 0; i < 4; i++) {
+                                seed_value += 0x9E3779B97F4A7C15ULL;
+                                uint64_t z = seed_value;
+                                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                                m_state[i] = z ^ (z >> 31);
+                        }
+                        m_bits_left = 0;
+                }
+
+                static constexpr result_type min() { return 0; }
+                static constexpr result_type max() { return UINT64_MAX; }
+
+                inline result_type operator()() {
+                        uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+                        uint64_t t      = m_state[1] << 17;
+                        m_state[2] ^= m_state[0];
+                        m_state[3] ^= m_state[1];
+                        m_state[1] ^= m_state[2];
+                        m_state[0] ^= m_state[3];
+                        m_state[2] ^= t;
+                        m_state[3]  = rotl(m_state[3], 45);
+                        return result;
+                }
+
+                // uniform in [0, range) for range > 0 without bias (lemire's multiply and shift,
+                // the division to compute the rejection threshold is only needed in rare cases)
+                inline uint32_t bounded( uint32_t range ) {
+                        return bounded( range, (uint32_t) ((*this)() >> 32) );
+                }
+
+                // two independent numbers in [0, range) from a single draw
+                inline void bounded_pair( uint32_t range, uint32_t & first, uint32_t & second ) {
+                        uint64_t r = (*this)();
+                        first  = bounded( range, (uint32_t) (r >> 32) );
+                        second = bounded( range, (uint32_t) r );
+                }
+
+                // one bit of a buffered number per call
+                inline bool next_bool() {
+                        if( m_bits_left == 0 ) {
+                                m_bits      = (*this)();
+                                m_bits_left = 64;
+                        }
+                        bool result = m_bits & 1;
+                        m_bits >>= 1;
+                        m_bits_left--;
+                        return result;
+                }
+
+        private:
+                static inline uint64_t rotl( uint64_t x, int k ) {
+                        return (x << k) | (x >> (64 - k));
+                }
+
+                inline uint32_t bounded( uint32_t range, uint32_t x ) {
+                        uint64_t m = (uint64_t) x * range;
+                        uint32_t l = (uint32_t) m;
+                        if( l < range ) {
+                                uint32_t threshold = -range % range;
+                                while( l < threshold ) {
+                                        x = (uint32_t) ((*this)() >> 32);
+                                        m = (uint64_t) x * range;
+                                        l = (uint32_t) m;
+                                }
+                        }
+                        return (uint32_t) (m >> 32);
+                }
+
+                uint64_t m_state[4];
+                uint64_t m_bits;        // unused bits for next_bool
+                unsigned m_bits_left;
+};
+
+typedef xoshiro256 random_generator;
 
 class random_functions {
         public:
@@ -45,15 +131,12 @@ class random_functions {
                                 }                   
 
                                 unsigned int size = vec.size();
-                                std::uniform_int_distribution<unsigned int> A(0,size-1);
-                                std::uniform_int_distribution<unsigned int> B(0,size-1);
-
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA, posB;
+                                        m_mt.bounded_pair(size, posA, posB);
 
                                         while(posB == posA) {
-                                                posB = B(m_mt);
+                                                posB = m_mt.bounded(size);
                                         }
 
                                         if( posA != vec[posB] && posB != vec[posA]) {
@@ -74,11 +157,10 @@ class random_functions {
                                 if(vec.size() < 10) return;
 
                                 int distance = 20; 
-                                std::uniform_int_distribution<unsigned int> A(0, distance);
                                 unsigned int size = vec.size()-4;
                                 for( unsigned int i = 0; i < size; i++) {
                                         unsigned int posA = i;
-                                        unsigned int posB = (posA + A(m_mt))%size;
+                                        unsigned int posB = (posA + m_mt.bounded(distance + 1))%size;
                                         std::swap(vec[posA], vec[posB]);
                                         std::swap(vec[posA+1], vec[posB+1]); 
                                         std::swap(vec[posA+2], vec[posB+2]); 
@@ -91,12 +173,9 @@ class random_functions {
                         unsigned int size = vec.size();
                         if(size < 4) return;
 
-                        std::uniform_int_distribution<unsigned int> A(0,size - 4);
-                        std::uniform_int_distribution<unsigned int> B(0,size - 4);
-
                         for( unsigned int i = 0; i < size; i++) {
-                                unsigned int posA = A(m_mt);
-                                unsigned int posB = B(m_mt);
+                                unsigned int posA, posB;
+                                m_mt.bounded_pair(size - 3, posA, posB);
                                 std::swap(vec[posA], vec[posB]); 
                                 std::swap(vec[posA+1], vec[posB+1]); 
                                 std::swap(vec[posA+2], vec[posB+2]); 
@@ -117,12 +196,9 @@ class random_functions {
                                         return;
                                 }
                                 unsigned int size = vec.size();
-                                std::uniform_int_distribution<unsigned int> A(0,size - 4);
-                                std::uniform_int_distribution<unsigned int> B(0,size - 4);
-
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA, posB;
+                                        m_mt.bounded_pair(size - 3, posA, posB);
                                         std::swap(vec[posA], vec[posB]); 
                                         std::swap(vec[posA+1], vec[posB+1]); 
                                         std::swap(vec[posA+2], vec[posB+2]); 
@@ -135,16 +211,21 @@ class random_functions {
                         static void permutate_vector_good_small(std::vector<sometype> & vec) {
                                 if(vec.size() < 2) return;
                                 unsigned int size = vec.size();
-                                std::uniform_int_distribution<unsigned int> A(0,size-1);
-                                std::uniform_int_distribution<unsigned int> B(0,size-1);
-
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA, posB;
+                                        m_mt.bounded_pair(size, posA, posB);
                                         std::swap(vec[posA], vec[posB]); 
                                 } 
                         }
 
+                // uniformly random permutation (fisher-yates)
+                template<typename sometype>
+                        static void shuffle(std::vector<sometype> & vec) {
+                                for( unsigned int i = vec.size(); i > 1; i--) {
+                                        std::swap(vec[i-1], vec[m_mt.bounded(i)]);
+                                }
+                        }
+
                 template<typename sometype>
                         static void permutate_entries(const PartitionConfig & partition_config, 
                                         std::vector<sometype> & vec, 
@@ -164,19 +245,19 @@ class random_functions {
                         }
 
                 static bool nextBool() {
-                        std::uniform_int_distribution<unsigned int> A(0,1);
-                        return (bool) A(m_mt); 
+                        return m_mt.next_bool();
                 }
 
 
                 //including lb and rb
                 static unsigned nextInt(unsigned int lb, unsigned int rb) {
-                        std::uniform_int_distribution<unsigned int> A(lb,rb);
-                        return A(m_mt); 
+                        uint32_t range = rb - lb + 1;
+                        if( range == 0 ) return (unsigned) m_mt(); // [0, 2^32)
+                        return lb + m_mt.bounded(range);
                 }
 
                 static double nextDouble(double lb, double rb) {
-                        double rnbr   = (double) rand() / (double) RAND_MAX; // rnd in 0,1
+                        double rnbr   = (m_mt() >> 11) * (1.0 / 9007199254740992.0); // rnd in [0,1)
                         double length = rb - lb;
                         rnbr         *= length;
                         rnbr         += lb;
@@ -190,9 +271,25 @@ class random_functions {
                         m_mt.seed(m_seed);
                 }
 
+                // seed of the independent stream of a task (island, job, ...), it only depends on 
+                // seed and stream, i.e. not on the thread that runs the task (splitmix64 finalizer)
+                static int stream_seed(int seed, unsigned stream) {
+                        uint64_t z = ((uint64_t)(unsigned) seed << 32 | stream) + 0x9E3779B97F4A7C15ULL;
+                        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                        z =  z ^ (z >> 31);
+                        return (int)(z & 0x7FFFFFFF);
+                }
+
+                // generator of the calling thread, e.g. to save the stream of a task and continue it on another thread
+                static random_generator & generator() {
+                        return m_mt;
+                }
+
         private:
-                static int m_seed;
-                static MersenneTwister m_mt;
+                // every thread has its own generator, threads other than the main thread have to be seeded explicitly
+                static thread_local int m_seed;
+                static thread_local random_generator m_mt;
 };
 
 #endif /* end of include guard: RANDOM_FUNCTIONS_RMEPKWYT */
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * viem_graph_check.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef VIEM_GRAPH_CHECK_5HQ2XWLA
+#define VIEM_GRAPH_CHECK_5HQ2XWLA
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// checks a communication graph in CSR / Metis format (adjcwgt may be NULL): xadj is non-decreasing,
+// targets are in [0,n), weights are non-negative, there are no self-loops or parallel edges and 
+// every edge (u,v) has a reverse edge (v,u) with the same weight. the local search relies on the 
+// latter, an asymmetric graph makes its objective diverge from J
+inline bool viem_valid_graph( int n, const int* xadj, const int* adjcwgt, const int* adjncy ) {
+        if( n <= 0 || xadj[0] != 0 ) return false;
+        for( int node = 0; node < n; node++) {
+                if( xadj[node+1] < xadj[node] ) return false;
+        }
+
+        // (target, weight) of every edge, sorted by target within a node
+        std::vector< std::pair< int, int > > edges(xadj[n]);
+        for( int node = 0; node < n; node++) {
+                for( int e = xadj[node]; e < xadj[node+1]; e++) {
+                        int weight = adjcwgt != NULL ? adjcwgt[e] : 1;
+                        if( adjncy[e] < 0 || adjncy[e] >= n || adjncy[e] == node || weight < 0 ) return false;
+                        edges[e] = std::make_pair(adjncy[e], weight);
+                }
+                std::sort( edges.begin() + xadj[node], edges.begin() + xadj[node+1] );
+                for( int e = xadj[node] + 1; e < xadj[node+1]; e++) {
+                        if( edges[e].first == edges[e-1].first ) return false;
+                }
+        }
+
+        for( int node = 0; node < n; node++) {
+                for( int e = xadj[node]; e < xadj[node+1]; e++) {
+                        int target = edges[e].first;
+                        std::vector< std::pair< int, int > >::iterator end = edges.begin() + xadj[target+1];
+                        std::vector< std::pair< int, int > >::iterator reverse = std::lower_bound( edges.begin() + xadj[target], end, 
+                                                                                   std::make_pair(node, std::numeric_limits< int >::min()) );
+                        if( reverse == end || reverse->first != node || reverse->second != edges[e].second ) return false;
+                }
+        }
+        return true;
+}
+
+#endif /* end of include guard: VIEM_GRAPH_CHECK_5HQ2XWLA */
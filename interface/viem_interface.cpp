@@ -0,0 +1,124 @@
+/******************************************************************************
+ * viem_interface.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "configuration.h"
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/normal_matrix.h"
+#include "data_structure/matrix/online_distance_matrix.h"
+#include "mapping/mapping_algorithms.h"
+#include "partition/partition_config.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "viem_graph_check.h"
+#include "viem_interface.h"
+
+// above this number of PEs the distance matrix is not stored explicitly
+#define VIEM_MAX_STORED_DISTANCE_MATRIX 16384
+
+int process_mapping(int* n, int* xadj, int* adjcwgt, int* adjncy,
+                    int* hierarchy_parameter, int* distance_parameter, int hierarchy_depth,
+                    int mode_mapping, int seed, bool suppress_output,
+                    int* qap, int* perm_rank) {
+
+        if( !viem_valid_graph(*n, xadj, adjcwgt, adjncy) ) return VIEM_ERROR_INVALID_GRAPH;
+        if( hierarchy_depth <= 0 ) return VIEM_ERROR_INVALID_SYSTEM;
+
+        long num_PEs = 1;
+        for( int i = 0; i < hierarchy_depth; i++) {
+                if( hierarchy_parameter[i] <= 0 || distance_parameter[i] < 0 ) return VIEM_ERROR_INVALID_SYSTEM;
+                num_PEs *= hierarchy_parameter[i];
+        }
+        if( num_PEs != *n ) return VIEM_ERROR_INVALID_SYSTEM;
+
+        std::streambuf* backup = std::cout.rdbuf();
+        std::ofstream ofs;
+        ofs.open("/dev/null");
+        if(suppress_output) {
+                std::cout.rdbuf(ofs.rdbuf());
+        }
+
+        PartitionConfig config;
+        configuration cfg;
+        cfg.standard(config);
+        cfg.eco(config);
+
+        switch( mode_mapping ) {
+                case VIEM_MAPMODE_FAST:
+                        config.preconfiguration_mapping = PRE_CONFIG_MAPPING_FAST;
+                        break;
+                case VIEM_MAPMODE_STRONG:
+                        config.preconfiguration_mapping = PRE_CONFIG_MAPPING_STRONG;
+                        break;
+                default:
+                        config.preconfiguration_mapping = PRE_CONFIG_MAPPING_ECO;
+        }
+
+        config.seed = seed;
+        random_functions::setSeed(seed);
+
+        config.group_sizes.clear();
+        config.distances.clear();
+        for( int i = 0; i < hierarchy_depth; i++) {
+                config.group_sizes.push_back(hierarchy_parameter[i]);
+                config.distances.push_back(distance_parameter[i]);
+        }
+        config.k = *n;
+
+        graph_access C;
+        std::vector< int > vwgt(*n, 1);
+        std::vector< int > unit_weights;
+        if( adjcwgt == NULL ) {
+                unit_weights.resize(xadj[*n], 1);
+                adjcwgt = &unit_weights[0];
+        }
+        C.build_from_metis_weighted(*n, xadj, adjncy, &vwgt[0], adjcwgt);
+
+        std::vector< NodeID > perm(config.k);
+        quality_metrics qm;
+        mapping_algorithms ma;
+        bool success = false;
+        if( config.k <= VIEM_MAX_STORED_DISTANCE_MATRIX ) {
+                config.distance_construction_algorithm = DIST_CONST_HIERARCHY;
+                normal_matrix D(config.k, config.k);
+                success = ma.construct_a_mapping(config, C, D, perm);
+                *qap    = qm.total_qap(C, D, perm);
+        } else {
+                config.distance_construction_algorithm = DIST_CONST_HIERARCHY_ONLINE;
+                online_distance_matrix D(config.k, config.k);
+                D.setPartitionConfig(config);
+                success = ma.construct_a_mapping(config, C, D, perm);
+                *qap    = qm.total_qap(C, D, perm);
+        }
+
+        ofs.close();
+        std::cout.rdbuf(backup);
+        if( !success ) return VIEM_ERROR_MAPPING_FAILED;
+
+        for( unsigned i = 0; i < perm.size(); i++) {
+                perm_rank[i] = perm[i];
+        }
+
+        return VIEM_OK;
+}
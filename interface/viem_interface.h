@@ -0,0 +1,61 @@
+/******************************************************************************
+ * viem_interface.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef VIEM_INTERFACE_RYEV9BSD
+#define VIEM_INTERFACE_RYEV9BSD
+
+#ifdef __cplusplus
+extern "C"
+{
+#else
+#include <stdbool.h>
+#endif
+
+// same as the --preconfiguration_mapping option of viem
+#define VIEM_MAPMODE_FAST           0
+#define VIEM_MAPMODE_ECO            1
+#define VIEM_MAPMODE_STRONG         2
+
+// return values of process_mapping
+#define VIEM_OK                     0
+#define VIEM_ERROR_INVALID_GRAPH    1
+#define VIEM_ERROR_INVALID_SYSTEM   2
+#define VIEM_ERROR_MAPPING_FAILED   3
+
+// computes a mapping of the communication graph (xadj, adjncy, adjcwgt in CSR / Metis format,
+// edges have to be present in both directions with the same weight) onto the hierarchy given by
+// hierarchy_parameter[0..hierarchy_depth) (e.g. 4 cores per socket, 2 sockets per node, ...)
+// and distance_parameter[0..hierarchy_depth) (distance between cores that share a socket, a node, ...).
+// the number of nodes n has to equal the product of the hierarchy parameters.
+// graphs with self-loops, parallel edges or missing reverse edges give VIEM_ERROR_INVALID_GRAPH.
+// adjcwgt may be NULL for unit communication volumes.
+// on success perm_rank[task] is the PE the task is mapped to and qap is J(C,D,perm_rank).
+// nothing is written to stdout if suppress_output is set.
+int process_mapping(int* n, int* xadj, int* adjcwgt, int* adjncy,
+                    int* hierarchy_parameter, int* distance_parameter, int hierarchy_depth,
+                    int mode_mapping, int seed, bool suppress_output,
+                    int* qap, int* perm_rank);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of include guard: VIEM_INTERFACE_RYEV9BSD */
@@ -95,17 +95,40 @@ int graph_io::readPartition(graph_access & G, std::string filename) {
 }
 
 int graph_io::readGraphWeighted(graph_access & G, std::string filename) {
+        std::string error;
+        int ret = readGraphWeighted(G, filename, error);
+        if( ret == 1 ) {
+                std::cerr << error << std::endl;
+                return 1;
+        } else if( ret == 2 ) {
+                std::cerr << error << std::endl;
+                exit(0);
+        }
+
+        //check for self-loops
+        forall_nodes(G, node) {
+                forall_out_edges(G, e, node) {
+                        if( G.getEdgeTarget(e) == node ) {
+                                std::cerr <<  "The graph file contains self-loops. This is not supported. Please remove them from the file."  << std::endl;
+                                return 0;
+                        }
+                } endfor
+        } endfor
+        return 0;
+}
+
+int graph_io::readGraphWeighted(graph_access & G, std::string filename, std::string & error) {
         std::string line;
 
         // open file for reading
         std::ifstream in(filename.c_str());
         if (!in) {
-                std::cerr << "Error opening " << filename << std::endl;
+                error = "Error opening " + filename;
                 return 1;
         }
 
-        long nmbNodes;
-        long nmbEdges;
+        long nmbNodes = -1;
+        long nmbEdges = -1;
 
         std::getline(in,line);
         //skip comments
@@ -119,9 +142,14 @@ int graph_io::readGraphWeighted(graph_access & G, std::string filename) {
         ss >> nmbEdges;
         ss >> ew;
 
+        if( nmbNodes < 0 || nmbEdges < 0 ) {
+                error = "The header of " + filename + " is invalid.";
+                return 2;
+        }
+
         if( 2*nmbEdges > std::numeric_limits<int>::max() || nmbNodes > std::numeric_limits<int>::max()) {
-                std::cerr <<  "The graph is too large. Currently only 32bit supported!"  << std::endl;
-                exit(0);
+                error = "The graph is too large. Currently only 32bit supported!";
+                return 2;
         }
 
         bool read_ew = false;
@@ -149,6 +177,10 @@ int graph_io::readGraphWeighted(graph_access & G, std::string filename) {
                         continue;
                 }
 
+                if( node_counter == (NodeID) nmbNodes ) {
+                        error = "number of specified nodes mismatch";
+                        return 2;
+                }
                 NodeID node = G.new_node(); node_counter++;
                 G.setPartitionIndex(node, 0);
 
@@ -159,24 +191,30 @@ int graph_io::readGraphWeighted(graph_access & G, std::string filename) {
                         ss >> weight;
                         total_nodeweight += weight;
                         if( total_nodeweight > (long long) std::numeric_limits<NodeWeight>::max()) {
-                                std::cerr <<  "The sum of the node weights is too large (it exceeds the node weight type)."  << std::endl;
-                                std::cerr <<  "Currently not supported. Please scale your node weights."  << std::endl;
-                                exit(0);
+                                error = "The sum of the node weights is too large (it exceeds the node weight type). "
+                                        "Currently not supported. Please scale your node weights.";
+                                return 2;
                         }
                 }
                 G.setNodeWeight(node, weight);
 
-                NodeID target;
+                long target;
                 while( ss >> target ) {
-                        //check for self-loops
-                        if(target-1 == node) {
-                                std::cerr <<  "The graph file contains self-loops. This is not supported. Please remove them from the file."  << std::endl;
+                        if( target < 1 || target > nmbNodes ) {
+                                std::stringstream msg;
+                                msg <<  "node " <<  node+1 <<  " has an edge to " <<  target <<  ", which is no node";
+                                error = msg.str();
+                                return 2;
                         }
 
                         EdgeWeight edge_weight = 1;
                         if( read_ew ) {
                                 ss >> edge_weight;
                         }
+                        if( edge_counter == (EdgeID) nmbEdges ) {
+                                error = "number of specified edges mismatch";
+                                return 2;
+                        }
                         edge_counter++;
                         EdgeID e = G.new_edge(node, target-1);
 
@@ -189,15 +227,17 @@ int graph_io::readGraphWeighted(graph_access & G, std::string filename) {
         }
 
         if( edge_counter != (EdgeID) nmbEdges ) {
-                std::cerr <<  "number of specified edges mismatch"  << std::endl;
-                std::cerr <<  edge_counter <<  " " <<  nmbEdges  << std::endl;
-                exit(0);
+                std::stringstream msg;
+                msg <<  "number of specified edges mismatch: " <<  edge_counter <<  " " <<  nmbEdges;
+                error = msg.str();
+                return 2;
         }
 
         if( node_counter != (NodeID) nmbNodes) {
-                std::cerr <<  "number of specified nodes mismatch"  << std::endl;
-                std::cerr <<  node_counter <<  " " <<  nmbNodes  << std::endl;
-                exit(0);
+                std::stringstream msg;
+                msg <<  "number of specified nodes mismatch: " <<  node_counter <<  " " <<  nmbNodes;
+                error = msg.str();
+                return 2;
         }
 
 
@@ -0,0 +1,161 @@
+/******************************************************************************
+ * memory_counters.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <atomic>
+#include <malloc.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memory_counters.h"
+
+static bool counting = false;
+static std::atomic< unsigned long long > allocations(0);
+static std::atomic< unsigned long long > allocated_bytes(0);
+static std::atomic< unsigned long long > freed_bytes(0);
+static std::atomic< long long > live(0);
+static std::atomic< long long > peak(0);
+
+static inline void* counted_malloc( size_t size ) {
+        void* p = malloc( size == 0 ? 1 : size );
+        if( counting && p != NULL ) {
+                long long bytes = malloc_usable_size(p);
+                allocations.fetch_add(1, std::memory_order_relaxed);
+                allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+                long long now  = live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                long long seen = peak.load(std::memory_order_relaxed);
+                while( now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed) );
+        }
+        return p;
+}
+
+static inline void counted_free( void* p ) {
+        if( p == NULL ) return;
+        if( counting ) {
+                // memory allocated before enable() makes live negative, peaks are relative anyway
+                long long bytes = malloc_usable_size(p);
+                freed_bytes.fetch_add(bytes, std::memory_order_relaxed);
+                live.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+        free(p);
+}
+
+// the shared library must not replace the allocator of the program that loads it
+#ifndef MODE_LIBRARY
+void* operator new( size_t size ) {
+        void* p = counted_malloc(size);
+        if( p == NULL ) throw std::bad_alloc();
+        return p;
+}
+
+void* operator new[]( size_t size ) {
+        void* p = counted_malloc(size);
+        if( p == NULL ) throw std::bad_alloc();
+        return p;
+}
+
+void* operator new( size_t size, const std::nothrow_t & ) throw() {
+        return counted_malloc(size);
+}
+
+void* operator new[]( size_t size, const std::nothrow_t & ) throw() {
+        return counted_malloc(size);
+}
+
+void operator delete( void* p ) throw() {
+        counted_free(p);
+}
+
+void operator delete[]( void* p ) throw() {
+        counted_free(p);
+}
+
+void operator delete( void* p, const std::nothrow_t & ) throw() {
+        counted_free(p);
+}
+
+void operator delete[]( void* p, const std::nothrow_t & ) throw() {
+        counted_free(p);
+}
+#endif
+
+void memory_counters::enable() {
+        counting = true;
+}
+
+bool memory_counters::enabled() {
+        return counting;
+}
+
+void memory_counters::read( unsigned long long values[MEMORY_NUM_COUNTERS] ) {
+        values[MEMORY_COUNTER_ALLOCATIONS]     = allocations.load();
+        values[MEMORY_COUNTER_ALLOCATED_BYTES] = allocated_bytes.load();
+        values[MEMORY_COUNTER_FREED_BYTES]     = freed_bytes.load();
+}
+
+unsigned long long memory_counters::live_bytes() {
+        long long bytes = live.load();
+        return bytes > 0 ? bytes : 0;
+}
+
+unsigned long long memory_counters::peak_bytes() {
+        long long bytes = peak.load();
+        return bytes > 0 ? bytes : 0;
+}
+
+unsigned long long memory_counters::reset_peak() {
+        long long previous = peak.exchange( live.load() );
+        return previous > 0 ? previous : 0;
+}
+
+void memory_counters::restore_peak( unsigned long long bytes ) {
+        long long seen = peak.load();
+        while( (long long) bytes > seen && !peak.compare_exchange_weak(seen, bytes) );
+}
+
+unsigned long long memory_counters::rss_kb() {
+        // stdio instead of streams, the sampling itself should not show up in the counters
+        FILE* status = fopen("/proc/self/status", "r");
+        if( status == NULL ) return 0;
+
+        char line[256];
+        unsigned long long rss = 0;
+        while( fgets(line, sizeof(line), status) != NULL ) {
+                if( strncmp(line, "VmRSS:", 6) == 0 ) {
+                        rss = strtoull( line + 6, NULL, 10 );
+                        break;
+                }
+        }
+        fclose(status);
+        return rss;
+}
+
+const char* memory_counters::name( int counter ) {
+        switch( counter ) {
+                case MEMORY_COUNTER_ALLOCATIONS:
+                        return "allocations";
+                case MEMORY_COUNTER_ALLOCATED_BYTES:
+                        return "allocated_bytes";
+                default:
+                        return "freed_bytes";
+        }
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * memory_counters.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef MEMORY_COUNTERS_4KD8WQ2P
+#define MEMORY_COUNTERS_4KD8WQ2P
+
+#define MEMORY_COUNTER_ALLOCATIONS      0
+#define MEMORY_COUNTER_ALLOCATED_BYTES  1
+#define MEMORY_COUNTER_FREED_BYTES      2
+#define MEMORY_NUM_COUNTERS             3
+
+// counts the allocations of all threads done through the global operator new / delete,
+// which are replaced in memory_counters.cpp. until enable() is called the replacement 
+// only forwards to malloc / free. sizes are the usable sizes reported by malloc. 
+// allocations done directly with malloc (e.g. by c code) are not counted.
+class memory_counters {
+        public:
+                static void enable();
+                static bool enabled();
+
+                // totals since enable()
+                static void read( unsigned long long values[MEMORY_NUM_COUNTERS] );
+
+                // bytes currently allocated (since enable())
+                static unsigned long long live_bytes();
+
+                // maximum of live_bytes() since the last reset_peak() 
+                static unsigned long long peak_bytes();
+
+                // restarts the peak at the current live bytes and returns the previous peak
+                static unsigned long long reset_peak();
+
+                // raises the peak to at least bytes, e.g. a previous peak returned by reset_peak()
+                static void restore_peak( unsigned long long bytes );
+
+                // current resident set size in kb (VmRSS), 0 if unavailable
+                static unsigned long long rss_kb();
+
+                static const char* name( int counter );
+};
+
+#endif /* end of include guard: MEMORY_COUNTERS_4KD8WQ2P */
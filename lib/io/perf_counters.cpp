@@ -0,0 +1,92 @@
+/******************************************************************************
+ * perf_counters.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "perf_counters.h"
+
+perf_counters::perf_counters() {
+        m_available = false;
+        for( int i = 0; i < PERF_NUM_COUNTERS; i++) {
+                m_fd[i] = -1;
+        }
+}
+
+perf_counters::~perf_counters() {
+        for( int i = 0; i < PERF_NUM_COUNTERS; i++) {
+                if( m_fd[i] != -1 ) close(m_fd[i]);
+        }
+}
+
+bool perf_counters::open() {
+#ifdef __linux__
+        const unsigned long long config[PERF_NUM_COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES, 
+                                                                PERF_COUNT_HW_INSTRUCTIONS, 
+                                                                PERF_COUNT_HW_CACHE_MISSES, 
+                                                                PERF_COUNT_HW_BRANCH_MISSES };
+        for( int i = 0; i < PERF_NUM_COUNTERS; i++) {
+                struct perf_event_attr attr;
+                memset(&attr, 0, sizeof(attr));
+                attr.type           = PERF_TYPE_HARDWARE;
+                attr.size           = sizeof(attr);
+                attr.config         = config[i];
+                attr.exclude_kernel = 1;
+                attr.exclude_hv     = 1;
+
+                // the counters of this thread on any cpu
+                m_fd[i] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+                if( m_fd[i] == -1 ) {
+                        for( int j = 0; j < i; j++) {
+                                close(m_fd[j]);
+                                m_fd[j] = -1;
+                        }
+                        return false;
+                }
+        }
+        m_available = true;
+#endif
+        return m_available;
+}
+
+void perf_counters::read( unsigned long long values[PERF_NUM_COUNTERS] ) {
+        for( int i = 0; i < PERF_NUM_COUNTERS; i++) {
+                values[i] = 0;
+                if( m_available && ::read(m_fd[i], &values[i], sizeof(values[i])) != sizeof(values[i]) ) {
+                        values[i] = 0;
+                }
+        }
+}
+
+const char* perf_counters::name( int counter ) {
+        switch( counter ) {
+                case PERF_COUNTER_CYCLES:        return "cycles";
+                case PERF_COUNTER_INSTRUCTIONS:  return "instructions";
+                case PERF_COUNTER_LLC_MISSES:    return "llc_misses";
+                case PERF_COUNTER_BRANCH_MISSES: return "branch_misses";
+        }
+        return "";
+}
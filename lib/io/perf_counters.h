@@ -0,0 +1,52 @@
+/******************************************************************************
+ * perf_counters.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef PERF_COUNTERS_8WC3NJ5T
+#define PERF_COUNTERS_8WC3NJ5T
+
+#define PERF_COUNTER_CYCLES         0
+#define PERF_COUNTER_INSTRUCTIONS   1
+#define PERF_COUNTER_LLC_MISSES     2
+#define PERF_COUNTER_BRANCH_MISSES  3
+#define PERF_NUM_COUNTERS           4
+
+// hardware counters of the calling thread via perf_event_open (linux only). if the
+// counters cannot be opened (other os, no pmu, perf_event_paranoid, ...) available()
+// is false and read() returns zeros.
+class perf_counters {
+        public:
+                perf_counters();
+                virtual ~perf_counters();
+
+                bool open();
+                bool available() { return m_available; }
+
+                // current values since open() 
+                void read( unsigned long long values[PERF_NUM_COUNTERS] );
+
+                static const char* name( int counter );
+
+        private:
+                int m_fd[PERF_NUM_COUNTERS];
+                bool m_available;
+};
+
+#endif /* end of include guard: PERF_COUNTERS_8WC3NJ5T */
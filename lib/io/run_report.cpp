@@ -0,0 +1,227 @@
+/******************************************************************************
+ * run_report.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <omp.h>
+#include <sys/resource.h>
+
+#include "run_report.h"
+
+bool run_report::m_enabled = false;
+bool run_report::m_perf_enabled = false;
+bool run_report::m_memory_enabled = false;
+perf_counters run_report::m_perf;
+run_report::phase run_report::m_root;
+std::vector< run_report::phase* > run_report::m_stack;
+std::map< std::string, unsigned long long > run_report::m_counters;
+std::map< std::string, double > run_report::m_values;
+
+void run_report::enable() {
+        m_enabled = true;
+        m_root.name  = "total";
+        m_root.time  = 0;
+        m_root.calls = 1;
+        m_root.t.restart();
+        m_stack.clear();
+        m_stack.push_back( &m_root );
+}
+
+bool run_report::enable_perf_counters() {
+        m_perf_enabled = m_perf.open();
+        m_perf.read( m_root.start_counters );
+        return m_perf_enabled;
+}
+
+void run_report::enable_memory_counters() {
+        m_memory_enabled = true;
+        memory_counters::enable();
+        memory_counters::read( m_root.start_memory );
+        memory_counters::reset_peak();
+        m_root.peak_bytes = 0;
+        m_root.max_rss_kb = 0;
+        sample_rss( &m_root );
+}
+
+void run_report::sample_rss( phase * p ) {
+        p->rss_kb     = memory_counters::rss_kb();
+        p->max_rss_kb = std::max( p->max_rss_kb, p->rss_kb );
+}
+
+void run_report::begin_phase( const std::string & name ) {
+        if( !m_enabled || omp_in_parallel() ) return;
+
+        phase* parent = m_stack.back();
+        phase* child  = NULL;
+        for( unsigned i = 0; i < parent->children.size(); i++) {
+                if( parent->children[i]->name == name ) {
+                        child = parent->children[i];
+                        break;
+                }
+        }
+        if( child == NULL ) {
+                child        = new phase();
+                child->name  = name;
+                child->time  = 0;
+                child->calls = 0;
+                for( int i = 0; i < PERF_NUM_COUNTERS; i++) {
+                        child->counters[i] = 0;
+                }
+                for( int i = 0; i < MEMORY_NUM_COUNTERS; i++) {
+                        child->memory[i] = 0;
+                }
+                child->peak_bytes = 0;
+                child->max_rss_kb = 0;
+                parent->children.push_back(child);
+        }
+        child->calls++;
+        child->t.restart();
+        if( m_perf_enabled ) m_perf.read( child->start_counters );
+        if( m_memory_enabled ) {
+                sample_rss( child );
+                memory_counters::read( child->start_memory );
+                child->outer_peak_bytes = memory_counters::reset_peak();
+        }
+        m_stack.push_back(child);
+}
+
+void run_report::end_phase() {
+        if( !m_enabled || omp_in_parallel() || m_stack.size() < 2 ) return;
+
+        phase* p = m_stack.back();
+        p->time += p->t.elapsed();
+        if( m_perf_enabled ) {
+                unsigned long long values[PERF_NUM_COUNTERS];
+                m_perf.read( values );
+                for( int i = 0; i < PERF_NUM_COUNTERS; i++) {
+                        p->counters[i] += values[i] - p->start_counters[i];
+                }
+        }
+        if( m_memory_enabled ) {
+                unsigned long long values[MEMORY_NUM_COUNTERS];
+                memory_counters::read( values );
+                for( int i = 0; i < MEMORY_NUM_COUNTERS; i++) {
+                        p->memory[i] += values[i] - p->start_memory[i];
+                }
+                p->peak_bytes = std::max( p->peak_bytes, memory_counters::peak_bytes() );
+                memory_counters::restore_peak( p->outer_peak_bytes );
+                sample_rss( p );
+        }
+        m_stack.pop_back();
+}
+
+void run_report::count( const std::string & name, unsigned long long value ) {
+        if( !m_enabled ) return;
+
+        #pragma omp critical (run_report)
+        {
+                m_counters[name] += value;
+        }
+}
+
+void run_report::set_value( const std::string & name, double value ) {
+        if( !m_enabled ) return;
+
+        #pragma omp critical (run_report)
+        {
+                m_values[name] = value;
+        }
+}
+
+void run_report::write_phase( std::ostream & out, phase * p, int indent ) {
+        std::string pad(indent, ' ');
+        out << pad << "{ \"name\": \"" << p->name << "\", \"time\": " << p->time 
+            << ", \"calls\": " << p->calls;
+        if( m_perf_enabled ) {
+                for( int i = 0; i < PERF_NUM_COUNTERS; i++) {
+                        out << ", \"" << perf_counters::name(i) << "\": " << p->counters[i];
+                }
+        }
+        if( m_memory_enabled ) {
+                for( int i = 0; i < MEMORY_NUM_COUNTERS; i++) {
+                        out << ", \"" << memory_counters::name(i) << "\": " << p->memory[i];
+                }
+                out << ", \"peak_heap_bytes\": " << p->peak_bytes 
+                    << ", \"rss_kb\": " << p->rss_kb << ", \"max_rss_kb\": " << p->max_rss_kb;
+        }
+        out << ", \"children\": [";
+        if( !p->children.empty() ) {
+                out << "\n";
+                for( unsigned i = 0; i < p->children.size(); i++) {
+                        write_phase( out, p->children[i], indent + 8 );
+                        out << (i+1 < p->children.size() ? ",\n" : "\n");
+                }
+                out << pad;
+        }
+        out << "] }";
+}
+
+bool run_report::write( const std::string & filename, const std::string & program ) {
+        if( !m_enabled ) return false;
+
+        std::ofstream out(filename.c_str());
+        if( !out ) return false;
+
+        m_root.time = m_root.t.elapsed();
+        if( m_perf_enabled ) {
+                unsigned long long values[PERF_NUM_COUNTERS];
+                m_perf.read( values );
+                for( int i = 0; i < PERF_NUM_COUNTERS; i++) {
+                        m_root.counters[i] = values[i] - m_root.start_counters[i];
+                }
+        }
+        if( m_memory_enabled ) {
+                unsigned long long values[MEMORY_NUM_COUNTERS];
+                memory_counters::read( values );
+                for( int i = 0; i < MEMORY_NUM_COUNTERS; i++) {
+                        m_root.memory[i] = values[i] - m_root.start_memory[i];
+                }
+                m_root.peak_bytes = std::max( m_root.peak_bytes, memory_counters::peak_bytes() );
+                sample_rss( &m_root );
+        }
+
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        out << std::setprecision(9);
+        out << "{\n";
+        out << "  \"program\": \"" << program << "\",\n";
+        out << "  \"peak_rss_kb\": " << usage.ru_maxrss << ",\n";
+        out << "  \"perf_counters\": " << (m_perf_enabled ? "true" : "false") << ",\n";
+        out << "  \"memory_counters\": " << (m_memory_enabled ? "true" : "false") << ",\n";
+        out << "  \"counters\": {";
+        for( std::map< std::string, unsigned long long >::iterator it = m_counters.begin(); it != m_counters.end(); ++it) {
+                out << (it == m_counters.begin() ? "\n" : ",\n") << "    \"" << it->first << "\": " << it->second;
+        }
+        out << (m_counters.empty() ? "},\n" : "\n  },\n");
+        out << "  \"values\": {";
+        out << std::setprecision(15); // objectives can exceed 2^32, print them without exponent
+        for( std::map< std::string, double >::iterator it = m_values.begin(); it != m_values.end(); ++it) {
+                out << (it == m_values.begin() ? "\n" : ",\n") << "    \"" << it->first << "\": " << it->second;
+        }
+        out << std::setprecision(9);
+        out << (m_values.empty() ? "},\n" : "\n  },\n");
+        out << "  \"phases\":\n";
+        write_phase( out, &m_root, 4 );
+        out << "\n}\n";
+        return true;
+}
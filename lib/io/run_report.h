@@ -0,0 +1,101 @@
+/******************************************************************************
+ * run_report.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef RUN_REPORT_2MF7QX9D
+#define RUN_REPORT_2MF7QX9D
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "memory_counters.h"
+#include "perf_counters.h"
+#include "timer.h"
+
+// registry of nested phase timers and counters of a run, written as json. nothing is
+// recorded unless enable() was called, then a phase costs two map lookups and a timer.
+// phases are only recorded outside of parallel regions, counters from all threads.
+class run_report {
+        public:
+                static void enable();
+                static bool enabled() { return m_enabled; }
+
+                // additionally reads hardware counters of the main thread around every phase.
+                // returns false if they are unavailable, the report is written without them then
+                static bool enable_perf_counters();
+
+                // additionally counts allocations and bytes of every phase (all threads), the peak
+                // of allocated bytes within the phase and the resident set size at its boundaries
+                static void enable_memory_counters();
+
+                // phases nest, i.e. a phase started within another one is its child
+                static void begin_phase( const std::string & name );
+                static void end_phase();
+
+                static void count( const std::string & name, unsigned long long value = 1 );
+
+                // a single value, e.g. an objective. overwrites the previous value of name
+                static void set_value( const std::string & name, double value );
+
+                static bool write( const std::string & filename, const std::string & program );
+
+        private:
+                struct phase {
+                        std::string name;
+                        double time;
+                        unsigned long long calls;
+                        timer_x t;
+                        std::vector< phase* > children;
+                        unsigned long long counters[PERF_NUM_COUNTERS];
+                        unsigned long long start_counters[PERF_NUM_COUNTERS];
+                        unsigned long long memory[MEMORY_NUM_COUNTERS];
+                        unsigned long long start_memory[MEMORY_NUM_COUNTERS];
+                        unsigned long long peak_bytes;
+                        unsigned long long outer_peak_bytes; // peak of the parent when the phase started
+                        unsigned long long rss_kb;           // at the end of the last call
+                        unsigned long long max_rss_kb;       // over all boundaries of the phase
+                };
+
+                static void write_phase( std::ostream & out, phase * p, int indent );
+                static void sample_rss( phase * p );
+
+                static bool m_enabled;
+                static bool m_perf_enabled;
+                static bool m_memory_enabled;
+                static perf_counters m_perf;
+                static phase m_root;
+                static std::vector< phase* > m_stack;
+                static std::map< std::string, unsigned long long > m_counters;
+                static std::map< std::string, double > m_values;
+};
+
+// records the lifetime of the object as a phase
+class report_phase {
+        public:
+                report_phase( const std::string & name ) {
+                        if( run_report::enabled() ) run_report::begin_phase( name );
+                }
+                ~report_phase() {
+                        if( run_report::enabled() ) run_report::end_phase();
+                }
+};
+
+#endif /* end of include guard: RUN_REPORT_2MF7QX9D */
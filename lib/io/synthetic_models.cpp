@@ -0,0 +1,170 @@
+/******************************************************************************
+ * synthetic_models.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <math.h>
+
+#include "random_functions.h"
+#include "synthetic_models.h"
+
+void synthetic_models::add_edge( std::vector< weighted_edge > & edges, NodeID u, NodeID v, EdgeWeight weight) {
+        if( u == v ) return;
+        weighted_edge e;
+        e.weight = weight;
+        e.source = u; e.target = v;
+        edges.push_back(e);
+        e.source = v; e.target = u;
+        edges.push_back(e);
+}
+
+void synthetic_models::build_graph( NodeID n, std::vector< weighted_edge > & edges, graph_access & G) {
+        std::sort( edges.begin(), edges.end() );
+
+        // merge parallel edges
+        unsigned m = 0;
+        for( unsigned i = 0; i < edges.size(); i++) {
+                if( m > 0 && edges[m-1].source == edges[i].source && edges[m-1].target == edges[i].target ) {
+                        edges[m-1].weight += edges[i].weight;
+                } else {
+                        edges[m++] = edges[i];
+                }
+        }
+        edges.resize(m);
+
+        G.start_construction(n, m);
+        unsigned pos = 0;
+        for( NodeID node = 0; node < n; node++) {
+                NodeID shadow = G.new_node();
+                G.setNodeWeight(shadow, 1);
+                for( ; pos < m && edges[pos].source == node; pos++) {
+                        EdgeID e = G.new_edge(shadow, edges[pos].target);
+                        G.setEdgeWeight(e, edges[pos].weight);
+                }
+        }
+        G.finish_construction();
+}
+
+void synthetic_models::grid_2d( NodeID n, graph_access & G) {
+        NodeID width = std::max(1, (int) floor(sqrt((double) n)));
+        std::vector< weighted_edge > edges;
+        for( NodeID node = 0; node < n; node++) {
+                if( (node+1) % width != 0 && node+1 < n ) add_edge( edges, node, node+1, 1);
+                if( node + width < n )                    add_edge( edges, node, node+width, 1);
+        }
+        build_graph( n, edges, G);
+}
+
+void synthetic_models::grid_3d( NodeID n, graph_access & G) {
+        NodeID width = std::max(1, (int) floor(cbrt((double) n)));
+        NodeID layer = width*width;
+        std::vector< weighted_edge > edges;
+        for( NodeID node = 0; node < n; node++) {
+                if( (node+1) % width != 0 && node+1 < n )                   add_edge( edges, node, node+1, 1);
+                if( (node % layer) + width < layer && node + width < n )    add_edge( edges, node, node+width, 1);
+                if( node + layer < n )                                      add_edge( edges, node, node+layer, 1);
+        }
+        build_graph( n, edges, G);
+}
+
+void synthetic_models::random_geometric( NodeID n, double avg_degree, graph_access & G) {
+        double radius = sqrt( avg_degree / (M_PI * n) );
+        std::vector< double > x(n), y(n);
+        for( NodeID node = 0; node < n; node++) {
+                x[node] = random_functions::nextDouble(0, 1);
+                y[node] = random_functions::nextDouble(0, 1);
+        }
+
+        // bucket the points into cells of side length radius, only neighboring cells have to be checked
+        int cells = std::max(1, (int) floor(1.0 / radius));
+        std::vector< std::vector< NodeID > > grid(cells*cells);
+        for( NodeID node = 0; node < n; node++) {
+                int cx = std::min(cells-1, (int) (x[node]*cells));
+                int cy = std::min(cells-1, (int) (y[node]*cells));
+                grid[cx*cells+cy].push_back(node);
+        }
+
+        std::vector< weighted_edge > edges;
+        for( NodeID node = 0; node < n; node++) {
+                int cx = std::min(cells-1, (int) (x[node]*cells));
+                int cy = std::min(cells-1, (int) (y[node]*cells));
+                for( int nx = std::max(0, cx-1); nx <= std::min(cells-1, cx+1); nx++) {
+                        for( int ny = std::max(0, cy-1); ny <= std::min(cells-1, cy+1); ny++) {
+                                for( NodeID other : grid[nx*cells+ny] ) {
+                                        if( other <= node ) continue;
+                                        double dx = x[node] - x[other];
+                                        double dy = y[node] - y[other];
+                                        if( dx*dx + dy*dy <= radius*radius ) add_edge( edges, node, other, 1);
+                                }
+                        }
+                }
+        }
+        build_graph( n, edges, G);
+}
+
+void synthetic_models::power_law( NodeID n, double avg_degree, double gamma, graph_access & G) {
+        // expected degree of node i is proportional to (i+1)^(-1/(gamma-1))
+        std::vector< double > prefix(n+1, 0);
+        for( NodeID node = 0; node < n; node++) {
+                prefix[node+1] = prefix[node] + pow( node+1, -1.0/(gamma-1));
+        }
+
+        std::vector< weighted_edge > edges;
+        unsigned long num_edges = (unsigned long) (avg_degree * n / 2);
+        for( unsigned long i = 0; i < num_edges; i++) {
+                double r_u = random_functions::nextDouble(0, prefix[n]);
+                double r_v = random_functions::nextDouble(0, prefix[n]);
+                NodeID u   = std::upper_bound( prefix.begin(), prefix.end(), r_u ) - prefix.begin() - 1;
+                NodeID v   = std::upper_bound( prefix.begin(), prefix.end(), r_v ) - prefix.begin() - 1;
+                add_edge( edges, std::min(u, n-1), std::min(v, n-1), random_functions::nextInt(1, 10));
+        }
+        build_graph( n, edges, G);
+}
+
+void synthetic_models::all_to_all_blocks( NodeID n, NodeID block_size, graph_access & G) {
+        std::vector< weighted_edge > edges;
+        for( NodeID start = 0; start < n; start += block_size) {
+                NodeID end = std::min(n, start + block_size);
+                for( NodeID u = start; u < end; u++) {
+                        for( NodeID v = u+1; v < end; v++) {
+                                add_edge( edges, u, v, 10);
+                        }
+                }
+                if( end < n ) add_edge( edges, end-1, end, 1);
+        }
+        build_graph( n, edges, G);
+}
+
+bool synthetic_models::generate( std::string name, NodeID n, graph_access & G) {
+        if( name == "grid2d" ) {
+                grid_2d( n, G );
+        } else if( name == "grid3d" ) {
+                grid_3d( n, G );
+        } else if( name == "rgg" ) {
+                random_geometric( n, 8, G );
+        } else if( name == "powerlaw" ) {
+                power_law( n, 8, 2.5, G );
+        } else if( name == "alltoall" ) {
+                all_to_all_blocks( n, 16, G );
+        } else {
+                return false;
+        }
+        return true;
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * synthetic_models.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef SYNTHETIC_MODELS_5HQ8ZT1R
+#define SYNTHETIC_MODELS_5HQ8ZT1R
+
+#include <string>
+#include <vector>
+
+#include "definitions.h"
+#include "data_structure/graph_access.h"
+
+// generators for synthetic communication graphs with n nodes, unit node weights and
+// symmetric edges. randomized generators use random_functions, i.e. the seed set there.
+class synthetic_models {
+        public:
+                // 5-point stencil on a grid of about sqrt(n) x sqrt(n) nodes
+                static void grid_2d( NodeID n, graph_access & G);
+
+                // 7-point stencil on a grid of about n^(1/3) x n^(1/3) x n^(1/3) nodes
+                static void grid_3d( NodeID n, graph_access & G);
+
+                // random points in the unit square, nodes are connected if their distance is 
+                // below a radius that yields average degree avg_degree
+                static void random_geometric( NodeID n, double avg_degree, graph_access & G);
+
+                // chung-lu graph with a power law degree distribution (exponent gamma), the
+                // communication volumes are random in [1, 10]
+                static void power_law( NodeID n, double avg_degree, double gamma, graph_access & G);
+
+                // all-to-all communication inside blocks of block_size nodes (volume 10), 
+                // consecutive blocks are connected by a single edge (volume 1)
+                static void all_to_all_blocks( NodeID n, NodeID block_size, graph_access & G);
+
+                // one of the above by name (grid2d, grid3d, rgg, powerlaw, alltoall) with default parameters, 
+                // returns false if the name is unknown
+                static bool generate( std::string name, NodeID n, graph_access & G);
+
+        private:
+                struct weighted_edge {
+                        NodeID source;
+                        NodeID target;
+                        EdgeWeight weight;
+
+                        bool operator<( const weighted_edge & rhs ) const {
+                                return source < rhs.source || (source == rhs.source && target < rhs.target);
+                        }
+                };
+
+                static void add_edge( std::vector< weighted_edge > & edges, NodeID u, NodeID v, EdgeWeight weight);
+
+                // builds G from an edge list containing both directions of every edge, 
+                // self loops are dropped and the weights of parallel edges are summed up
+                static void build_graph( NodeID n, std::vector< weighted_edge > & edges, graph_access & G);
+};
+
+#endif /* end of include guard: SYNTHETIC_MODELS_5HQ8ZT1R */
@@ -22,9 +22,13 @@
 #include "communication_graph_search_space.h"
 #include "tools/random_functions.h"
 
-int global_num_nodes = 0;
-
 communication_graph_search_space::communication_graph_search_space(PartitionConfig & config, NodeID number_of_nodes) {
+        reset(config, number_of_nodes);
+}
+
+void communication_graph_search_space::reset(PartitionConfig & config, NodeID number_of_nodes) {
+        m_list_of_pairs.clear();
+        m_pair_active.clear();
         m_pointer       = 0;
         m_last_pointer  = 0;
         m_unsucc_tries  = 0;
@@ -32,7 +36,6 @@ communication_graph_search_space::communication_graph_search_space(PartitionConf
         m_search_deepth = config.communication_neighborhood_dist;
         m_have_to_break = false;
         m_deepth.resize(number_of_nodes);
-        global_num_nodes = number_of_nodes;
 	this->config = config;
 }
 
@@ -28,17 +28,15 @@
 #include "tools/random_functions.h"
 #include "partition_config.h"
 
-extern int global_num_nodes;
-
 namespace std {
         template <>
                 struct hash< std::pair<NodeID, NodeID> > {
                         public:
                                 size_t operator()(const std::pair<NodeID, NodeID> & x) const throw() {
                                         if( x.first < x.second ) 
-                                                return x.second*global_num_nodes + x.first;
+                                                return ((size_t) x.second << 32) + x.first;
                                         else 
-                                                return x.first*global_num_nodes + x.second;
+                                                return ((size_t) x.first << 32) + x.second;
                                 }
                 };
 }
@@ -48,6 +46,9 @@ class communication_graph_search_space {
                 communication_graph_search_space(PartitionConfig & config, NodeID number_of_nodes);
                 virtual ~communication_graph_search_space(); 
 
+                // prepares the object for a new graph, allocated memory is kept
+                void reset(PartitionConfig & config, NodeID number_of_nodes);
+
 		void set_graph_ref( graph_access * C);
 
                 bool done() {
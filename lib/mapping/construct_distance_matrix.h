@@ -31,11 +31,12 @@ public:
         construct_distance_matrix();
         virtual ~construct_distance_matrix();
 
-        void construct_matrix( PartitionConfig & config, matrix & D ) {
+        // returns false if D is not a square matrix
+        bool construct_matrix( PartitionConfig & config, matrix & D ) {
                 //check wether distance matrix is a square matrix
                 if(D.get_x_dim() != D.get_y_dim()) {
                         std::cout <<  "distance matrix is not symmetric."  << std::endl;
-                        exit(0);
+                        return false;
                 }
 
                 switch( config.distance_construction_algorithm ) {
@@ -53,6 +54,7 @@ public:
                         default: 
                                 construct_matrix_random( config, D );
                 }
+                return true;
         };
 
 private:
@@ -47,7 +47,12 @@ void construct_mapping::construct_initial_mapping( PartitionConfig & config, gra
                         break;
                 case MAP_CONST_OLDGROWING_FASTER:
                         std::cout <<  "running faster growing"  << std::endl;
-                        construct_old_growing_faster( config, C, D, perm_rank);
+                        if( config.distance_construction_algorithm == DIST_CONST_HIERARCHY 
+                         || config.distance_construction_algorithm == DIST_CONST_HIERARCHY_ONLINE ) {
+                                construct_growing_hierarchy( config, C, D, perm_rank);
+                        } else {
+                                construct_old_growing_faster( config, C, D, perm_rank);
+                        }
                         break;
                 case MAP_CONST_FASTHIERARCHY_BOTTOMUP:
                         std::cout <<  "running fast hierarchy bottom up"  << std::endl;
@@ -175,6 +180,107 @@ void construct_mapping::construct_old_growing_faster( PartitionConfig & config,
         } 
 }
 
+// same greedy as construct_old_growing_faster, but the PE with minimum total distance to the assigned PEs
+// is found using the hierarchy: for a PE p whose group on level l is g_l we have
+//      total_dist(p) = sum_l assigned(g_l) * (distances[l] - distances[l+1]),  distances[L] = 0,
+// i.e. it only depends on the number of assigned PEs in the groups containing p.
+// a tree over the groups stores the minimum over all free PEs of each subtree, 
+// an assignment updates one path of the tree in O(sum of group sizes).
+void construct_mapping::construct_growing_hierarchy( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        std::cout <<  "constructing initial mapping with hierarchical growing"  << std::endl;
+
+        unsigned num_levels = config.group_sizes.size();
+        std::vector< NodeID > interval_sizes(num_levels, 0);
+        interval_sizes[0] = config.group_sizes[0];
+        for( unsigned l = 1; l < num_levels; l++) {
+                interval_sizes[l] = config.group_sizes[l]*interval_sizes[l-1];
+        }
+
+        std::vector< long > level_factor(num_levels, 0);
+        for( unsigned l = 0; l < num_levels; l++) {
+                long next_distance = l + 1 < num_levels ? config.distances[l+1] : 0;
+                level_factor[l]    = config.distances[l] - next_distance;
+        }
+
+        const long no_free_PE = std::numeric_limits< long >::max();
+        std::vector< std::vector< NodeID > > assigned(num_levels);
+        std::vector< std::vector< long > > min_dist(num_levels);
+        for( unsigned l = 0; l < num_levels; l++) {
+                assigned[l].resize(C.number_of_nodes() / interval_sizes[l], 0);
+                min_dist[l].resize(C.number_of_nodes() / interval_sizes[l], 0);
+        }
+
+        for( unsigned int i = 0; i < perm_rank.size(); i++) {
+                perm_rank[i] = UNASSIGNED;
+        }
+
+        maxNodeHeap unassigned_tasks; // contains unassigned tasks and their priority
+        NodeWeight max_vol      = 0;
+        NodeWeight max_vol_elem = 0;
+        forall_nodes(C, node) {
+                NodeWeight cur_vol = 0;
+                forall_out_edges(C, e, node) {
+                        cur_vol += C.getEdgeWeight(e);
+                } endfor
+
+                unassigned_tasks.insert( node, 0);
+
+                if( cur_vol > max_vol ) {
+                        max_vol = cur_vol;
+                        max_vol_elem = node;
+                }
+        } endfor
+
+        NodeID cur_task = max_vol_elem;
+        unassigned_tasks.deleteNode(cur_task);
+        NodeID cur_PE = 0; // all PEs have the same total distance in the beginning
+
+        while( true ) {
+                perm_rank[cur_task] = cur_PE;
+
+                //update priorities
+                forall_out_edges(C, e, cur_task) {
+                        NodeID target_task = C.getEdgeTarget(e);
+                        if( unassigned_tasks.contains(target_task) ) {
+                                unassigned_tasks.changeKey(target_task, unassigned_tasks.getKey(target_task) + C.getEdgeWeight(e));
+                        }
+                } endfor
+
+                if( unassigned_tasks.size() == 0 ) break;
+
+                // update the path of cur_PE in the group tree
+                for( unsigned l = 0; l < num_levels; l++) {
+                        NodeID group = cur_PE / interval_sizes[l];
+                        assigned[l][group]++;
+
+                        long best_child = no_free_PE;
+                        if( l == 0 ) {
+                                if( assigned[0][group] < interval_sizes[0] ) best_child = 0; 
+                        } else {
+                                NodeID first_child = group * config.group_sizes[l];
+                                for( NodeID child = first_child; child < first_child + config.group_sizes[l]; child++) {
+                                        best_child = std::min(best_child, min_dist[l-1][child]);
+                                }
+                        }
+                        min_dist[l][group] = best_child == no_free_PE ? no_free_PE : best_child + assigned[l][group]*level_factor[l];
+                }
+
+                // descend to the free PE with minimum total distance
+                NodeID group = 0;
+                for( int l = num_levels - 1; l > 0; l--) {
+                        NodeID first_child = group * config.group_sizes[l];
+                        NodeID best_child  = first_child;
+                        for( NodeID child = first_child; child < first_child + config.group_sizes[l]; child++) {
+                                if( min_dist[l-1][child] < min_dist[l-1][best_child] ) best_child = child;
+                        }
+                        group = best_child;
+                }
+                // PEs of a group on the lowest level are assigned in order
+                cur_PE   = group * interval_sizes[0] + assigned[0][group];
+                cur_task = unassigned_tasks.deleteMax();
+        } 
+}
+
 void construct_mapping::construct_identity( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
         for( unsigned int i = 0; i < perm_rank.size(); i++) {
                 perm_rank[i] = i;
@@ -36,6 +36,7 @@ class construct_mapping {
                 void construct_initial_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
 
                 void construct_old_growing_faster( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+                void construct_growing_hierarchy( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
                 void construct_identity( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
                 void construct_random( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
                 void construct_fast_hierarchy_topdown( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
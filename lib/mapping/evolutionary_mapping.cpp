@@ -0,0 +1,363 @@
+/******************************************************************************
+ * evolutionary_mapping.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <omp.h>
+
+#include "communication_graph_search_space.h"
+#include "data_structure/priority_queues/maxNodeHeap.h"
+#include "evolutionary_mapping.h"
+#include "full_search_space.h"
+#include "full_search_space_pruned.h"
+#include "local_search_mapping.h"
+#include "qap_lower_bound.h"
+#include "tools/null_buffer.h"
+#include "tools/random_functions.h"
+#include "tools/timer.h"
+
+evolutionary_mapping::evolutionary_mapping() {
+
+}
+
+evolutionary_mapping::~evolutionary_mapping() {
+
+}
+
+void evolutionary_mapping::perform_evolution( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        mapping_individuum input;
+        input.perm_rank = perm_rank;
+        input.objective = qm.total_qap(C, D, perm_rank);
+
+        // the islands reseed the generators of the threads they run on
+        random_generator main_stream = random_functions::generator();
+
+        std::vector< mapping_individuum > output;
+        {
+                // the islands run their local searches in parallel, their output would interleave
+                silence_output quiet;
+                if( config.deterministic ) {
+                        run_islands_deterministic( config, C, D, input, output );
+                } else {
+                        unsigned num_islands = config.num_islands > 0 ? config.num_islands : std::max(1, config.num_threads);
+
+                        mapping_mailbox mailbox(num_islands);
+                        for( unsigned i = 0; i < num_islands; i++) {
+                                mailbox[i].store(NULL);
+                        }
+
+                        output.resize(num_islands);
+
+                        #pragma omp parallel for num_threads(num_islands) schedule(static,1)
+                        for( unsigned island = 0; island < num_islands; island++) {
+                                PartitionConfig island_config = config;
+                                run_island( island_config, C, D, input, island, mailbox, output[island]);
+                        }
+
+                        for( unsigned i = 0; i < num_islands; i++) {
+                                delete mailbox[i].load();
+                        }
+                }
+        }
+        random_functions::generator() = main_stream;
+
+        unsigned best = 0;
+        for( unsigned i = 1; i < output.size(); i++) {
+                if( output[i].objective < output[best].objective ) best = i;
+        }
+        if( output[best].objective < input.objective ) {
+                perm_rank = output[best].perm_rank;
+        }
+
+        std::cout <<  "evolutionary mapping islands " <<  output.size()
+                  <<  ", J(C,D,Pi) = " <<  std::min(output[best].objective, input.objective)
+                  <<  " (was " <<  input.objective << ")" << std::endl;
+}
+
+void evolutionary_mapping::run_island( PartitionConfig & config, graph_access & C, matrix & D,
+                                       mapping_individuum & input, unsigned island,
+                                       mapping_mailbox & mailbox, mapping_individuum & output) {
+        timer_x t; t.restart();
+
+        // every island draws from its own stream
+        random_functions::setSeed(random_functions::stream_seed(config.seed, island));
+
+        mapping_population population(config);
+        initialize_population( config, C, D, input, population );
+
+        // the local searches of a generation get the time that is left of the island
+        double time_limit          = config.time_limit;
+        unsigned num_islands       = mailbox.size();
+        unsigned exchange_interval = std::max(1u, config.mh_pool_size);
+        for( unsigned generation = 1; ; generation++) {
+                if( time_limit > 0 ) {
+                        config.time_limit = time_limit - t.elapsed();
+                        if( config.time_limit <= 0 ) break;
+                } else if( generation > config.evolutionary_generations ) {
+                        break;
+                }
+                if( qap_lower_bound::gap_reached( config, population.get(population.get_best_individuum()).objective ) ) break;
+
+                perform_generation( config, C, D, population );
+
+                if( num_islands > 1 && generation % exchange_interval == 0 ) {
+                        // post the best individuum, a copy that was not taken yet is replaced
+                        mapping_individuum* elite = new mapping_individuum(population.get(population.get_best_individuum()));
+                        delete mailbox[island].exchange(elite);
+
+                        // take the individuum of the previous island
+                        mapping_individuum* received = mailbox[(island + num_islands - 1) % num_islands].exchange(NULL);
+                        if( received != NULL ) {
+                                population.insert(*received);
+                                delete received;
+                        }
+                }
+        }
+
+        output = population.get(population.get_best_individuum());
+}
+
+void evolutionary_mapping::run_islands_deterministic( PartitionConfig & config, graph_access & C, matrix & D,
+                                                      mapping_individuum & input, std::vector< mapping_individuum > & output) {
+        unsigned num_islands       = config.num_islands > 0 ? config.num_islands : EVOLUTIONARY_DETERMINISTIC_ISLANDS;
+        unsigned num_threads       = std::min( num_islands, (unsigned) std::max(1, config.num_threads) );
+        unsigned exchange_interval = std::max(1u, config.mh_pool_size);
+
+        std::vector< mapping_population* > populations(num_islands, NULL);
+        std::vector< random_generator > streams(num_islands);
+        std::vector< bool > gap_reached(num_islands, false);
+
+        // an epoch is the initialization or exchange_interval generations of every island, the exchange
+        // between epochs happens in island order. hence neither the number of threads nor the
+        // assignment of islands to threads influence the result
+        unsigned generation = 0;
+        bool done = false;
+        while( !done ) {
+                unsigned last_generation = generation == 0 ? 0 : std::min( generation + exchange_interval - 1, config.evolutionary_generations );
+
+                #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+                for( unsigned island = 0; island < num_islands; island++) {
+                        PartitionConfig island_config = config;
+                        if( populations[island] == NULL ) {
+                                random_functions::setSeed(random_functions::stream_seed(config.seed, island));
+                                populations[island] = new mapping_population(island_config);
+                                initialize_population( island_config, C, D, input, *populations[island] );
+                        } else {
+                                random_functions::generator() = streams[island];
+                                for( unsigned g = generation; g <= last_generation; g++) {
+                                        mapping_population & population = *populations[island];
+                                        if( qap_lower_bound::gap_reached( island_config, population.get(population.get_best_individuum()).objective ) ) {
+                                                gap_reached[island] = true;
+                                                break;
+                                        }
+                                        perform_generation( island_config, C, D, population );
+                                }
+                        }
+                        streams[island] = random_functions::generator();
+                }
+
+                generation = last_generation + 1;
+                done       = generation > config.evolutionary_generations;
+                for( unsigned i = 0; i < num_islands; i++) {
+                        if( gap_reached[i] ) done = true;
+                }
+
+                if( !done && num_islands > 1 && last_generation > 0 ) {
+                        // island i receives the best individuum of island i-1
+                        std::vector< mapping_individuum > elites(num_islands);
+                        for( unsigned i = 0; i < num_islands; i++) {
+                                elites[i] = populations[i]->get(populations[i]->get_best_individuum());
+                        }
+                        for( unsigned i = 0; i < num_islands; i++) {
+                                populations[i]->insert( elites[(i + num_islands - 1) % num_islands] );
+                        }
+                }
+        }
+
+        output.resize(num_islands);
+        for( unsigned i = 0; i < num_islands; i++) {
+                output[i] = populations[i]->get(populations[i]->get_best_individuum());
+                delete populations[i];
+        }
+}
+
+void evolutionary_mapping::initialize_population( PartitionConfig & config, graph_access & C, matrix & D,
+                                                  mapping_individuum & input, mapping_population & population) {
+        timer_x t; t.restart();
+        PartitionConfig ls_config = config;
+
+        mapping_individuum ind = input;
+        population.insert(ind);
+        while( !population.is_full() ) {
+                if( config.time_limit > 0 ) {
+                        ls_config.time_limit = config.time_limit - t.elapsed();
+                        if( ls_config.time_limit <= 0 ) break; // the population stays smaller
+                }
+                ind = input;
+                mutate( config, C, ind );
+                local_search( ls_config, C, D, ind );
+                population.insert(ind);
+        }
+}
+
+void evolutionary_mapping::perform_generation( PartitionConfig & config, graph_access & C, matrix & D, mapping_population & population) {
+        unsigned first, second;
+        population.get_two_individuals_tournament(first, second);
+
+        mapping_individuum ind;
+        if( first == second ) {
+                ind = population.get(first);
+                mutate( config, C, ind );
+        } else {
+                combine( config, C, D, population.get(first), population.get(second), ind);
+        }
+        local_search( config, C, D, ind );
+        population.insert(ind);
+}
+
+void evolutionary_mapping::combine( PartitionConfig & config, graph_access & C, matrix & D,
+                                    mapping_individuum & first, mapping_individuum & second,
+                                    mapping_individuum & output) {
+        NodeID n           = C.number_of_nodes();
+        NodeID group_size  = config.group_sizes.size() > 0 ? config.group_sizes[0] : 1;
+        NodeID num_groups  = (n + group_size - 1) / group_size;
+
+        std::vector< NodeID > & perm_rank = output.perm_rank;
+        perm_rank.assign(n, UNASSIGNED);
+        std::vector< bool > PE_assigned(n, false);
+
+        // keep group assignments both parents agree on, preferably on the PE of one of the parents
+        for( unsigned pass = 0; pass < 2; pass++) {
+                std::vector< NodeID > & parent = pass == 0 ? first.perm_rank : second.perm_rank;
+                forall_nodes(C, node) {
+                        if( perm_rank[node] != UNASSIGNED ) continue;
+                        if( first.perm_rank[node] / group_size != second.perm_rank[node] / group_size ) continue;
+                        if( PE_assigned[parent[node]] ) continue;
+
+                        perm_rank[node]           = parent[node];
+                        PE_assigned[parent[node]] = true;
+                } endfor
+        }
+
+        std::vector< std::vector< NodeID > > free_PEs(num_groups);
+        for( NodeID PE = n; PE-- > 0; ) {
+                if( !PE_assigned[PE] ) free_PEs[PE / group_size].push_back(PE);
+        }
+
+        forall_nodes(C, node) {
+                if( perm_rank[node] != UNASSIGNED ) continue;
+                if( first.perm_rank[node] / group_size != second.perm_rank[node] / group_size ) continue;
+
+                std::vector< NodeID > & group = free_PEs[first.perm_rank[node] / group_size];
+                perm_rank[node] = group.back();
+                group.pop_back();
+        } endfor
+
+        // assign the remaining tasks, most connected to the assigned ones first
+        maxNodeHeap unassigned_tasks;
+        forall_nodes(C, node) {
+                if( perm_rank[node] != UNASSIGNED ) continue;
+
+                Gain vol = 0;
+                forall_out_edges(C, e, node) {
+                        if( perm_rank[C.getEdgeTarget(e)] != UNASSIGNED ) vol += C.getEdgeWeight(e);
+                } endfor
+                unassigned_tasks.insert(node, vol);
+        } endfor
+
+        NodeID next_free_group = 0;
+        while( unassigned_tasks.size() > 0 ) {
+                NodeID cur_task = unassigned_tasks.deleteMax();
+
+                // candidates are the free PEs in the groups of the assigned neighbors
+                NodeID best_PE        = UNASSIGNED;
+                NodeWeight best_cost  = std::numeric_limits< NodeWeight >::max();
+                forall_out_edges(C, e, cur_task) {
+                        NodeID target = C.getEdgeTarget(e);
+                        if( perm_rank[target] == UNASSIGNED ) continue;
+
+                        std::vector< NodeID > & group = free_PEs[perm_rank[target] / group_size];
+                        if( group.empty() ) continue;
+
+                        NodeID PE       = group.back();
+                        NodeWeight cost = 0;
+                        forall_out_edges(C, e_bar, cur_task) {
+                                NodeID target_bar = C.getEdgeTarget(e_bar);
+                                if( perm_rank[target_bar] == UNASSIGNED ) continue;
+                                cost += C.getEdgeWeight(e_bar)*D.get_xy(PE, perm_rank[target_bar]);
+                        } endfor
+
+                        if( cost < best_cost ) {
+                                best_cost = cost;
+                                best_PE   = PE;
+                        }
+                } endfor
+
+                if( best_PE == UNASSIGNED ) {
+                        while( free_PEs[next_free_group].empty() ) next_free_group++;
+                        best_PE = free_PEs[next_free_group].back();
+                }
+                free_PEs[best_PE / group_size].pop_back();
+                perm_rank[cur_task] = best_PE;
+
+                forall_out_edges(C, e, cur_task) {
+                        NodeID target = C.getEdgeTarget(e);
+                        if( unassigned_tasks.contains(target) ) {
+                                unassigned_tasks.changeKey(target, unassigned_tasks.getKey(target) + C.getEdgeWeight(e));
+                        }
+                } endfor
+        }
+
+        output.objective = qm.total_qap(C, D, perm_rank);
+}
+
+void evolutionary_mapping::mutate( PartitionConfig & config, graph_access & C, mapping_individuum & ind ) {
+        NodeID n         = C.number_of_nodes();
+        NodeID num_swaps = std::max(1u, n / 20);
+        for( NodeID i = 0; i < num_swaps; i++) {
+                NodeID lhs = random_functions::nextInt(0, n-1);
+                NodeID rhs = random_functions::nextInt(0, n-1);
+                std::swap(ind.perm_rank[lhs], ind.perm_rank[rhs]);
+        }
+}
+
+void evolutionary_mapping::local_search( PartitionConfig & config, graph_access & C, matrix & D, mapping_individuum & ind ) {
+        // the individuals are no checkpoints of the mapping and have no trace
+        PartitionConfig ls_config     = config;
+        ls_config.checkpoint_filename = "";
+        ls_config.trace_filename      = "";
+
+        // C passed the objective check of the local search of the input mapping, 
+        // hence the return values are not checked
+        local_search_mapping lsm;
+        switch( config.ls_neighborhood ) {
+                case NSQUARE:
+                        lsm.perform_local_search< full_search_space > ( ls_config, C, D, ind.perm_rank);
+                        break;
+                case NSQUAREPRUNED:
+                        lsm.perform_local_search< full_search_space_pruned > ( ls_config, C, D, ind.perm_rank);
+                        break;
+                case COMMUNICATIONGRAPH:
+                        lsm.perform_local_search< communication_graph_search_space > ( ls_config, C, D, ind.perm_rank);
+                        break;
+        }
+        ind.objective = qm.total_qap(C, D, ind.perm_rank);
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * evolutionary_mapping.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef EVOLUTIONARY_MAPPING_5RZK0B7T
+#define EVOLUTIONARY_MAPPING_5RZK0B7T
+
+#include <atomic>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/matrix.h"
+#include "mapping_population.h"
+#include "partition_config.h"
+#include "tools/quality_metrics.h"
+
+// number of islands in deterministic mode if none is given (independent of the number of threads)
+#define EVOLUTIONARY_DETERMINISTIC_ISLANDS 4
+
+// every island keeps its own population and runs on its own thread.
+// islands are arranged in a ring, island i posts copies of its best individuum
+// into mailbox i and island i+1 takes them out. a mailbox slot only changes
+// its owner by an atomic exchange, hence no locks are needed.
+// in deterministic mode the islands instead run in epochs and exchange in a fixed order
+// between them, then the result does not depend on the number of threads.
+typedef std::vector< std::atomic< mapping_individuum* > > mapping_mailbox;
+
+class evolutionary_mapping {
+public:
+        evolutionary_mapping();
+        virtual ~evolutionary_mapping();
+
+        // input a valid mapping
+        // output the best mapping found by all islands
+        void perform_evolution( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+private:
+        void run_island( PartitionConfig & config, graph_access & C, matrix & D,
+                         mapping_individuum & input, unsigned island,
+                         mapping_mailbox & mailbox, mapping_individuum & output);
+
+        void run_islands_deterministic( PartitionConfig & config, graph_access & C, matrix & D,
+                                        mapping_individuum & input, std::vector< mapping_individuum > & output);
+
+        // the input and mutations of it improved by local search
+        void initialize_population( PartitionConfig & config, graph_access & C, matrix & D,
+                                    mapping_individuum & input, mapping_population & population);
+
+        // selection, combine or mutate, local search and insertion of the offspring
+        void perform_generation( PartitionConfig & config, graph_access & C, matrix & D, mapping_population & population);
+
+        // keeps the assignment of a task to a group of the lowest hierarchy level if both parents agree on it,
+        // the remaining tasks are assigned greedily to free PEs close to their already assigned neighbors
+        void combine( PartitionConfig & config, graph_access & C, matrix & D,
+                      mapping_individuum & first, mapping_individuum & second,
+                      mapping_individuum & output);
+
+        void mutate( PartitionConfig & config, graph_access & C, mapping_individuum & ind );
+
+        void local_search( PartitionConfig & config, graph_access & C, matrix & D, mapping_individuum & ind );
+
+        quality_metrics qm;
+};
+
+
+#endif /* end of include guard: EVOLUTIONARY_MAPPING_5RZK0B7T */
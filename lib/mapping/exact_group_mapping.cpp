@@ -0,0 +1,301 @@
+/******************************************************************************
+ * exact_group_mapping.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <omp.h>
+
+#include "exact_group_mapping.h"
+#include "qap_lower_bound.h"
+#include "run_report.h"
+#include "tools/timer.h"
+
+#define EXACT_MAX_ROUNDS 10
+#define EXACT_MAX_BRANCH_NODES 1000000
+
+exact_group_mapping::exact_group_mapping() {
+
+}
+
+exact_group_mapping::~exact_group_mapping() {
+
+}
+
+void exact_group_mapping::perform_refinement( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        if( config.group_sizes.size() < 2 || config.group_sizes[1] < 2 ) return; // there are no sibling groups
+
+        timer_x t; t.restart();
+        long long input_objective = qm.total_qap(C, D, perm_rank);
+        long long cur_objective   = input_objective;
+        std::vector< bool > in_unit(C.number_of_nodes(), false);
+
+        unsigned truncated_units = 0;
+        unsigned unsucc_rounds   = 0;
+        for( unsigned round = 0; round < EXACT_MAX_ROUNDS && unsucc_rounds < 2; round++) {
+                if( qap_lower_bound::gap_reached( config, cur_objective ) ) break;
+                if( config.time_limit > 0 && t.elapsed() > config.time_limit ) break;
+
+                // alternate the pairing of sibling groups
+                std::vector< mapping_unit > units;
+                build_units( config, C, perm_rank, round % 2, units);
+
+                #pragma omp parallel for num_threads(std::max(1, config.num_threads)) schedule(dynamic)
+                for( unsigned i = 0; i < units.size(); i++) {
+                        solve_unit( config, C, D, perm_rank, units[i]);
+                }
+
+                // units do not influence each other, the gains are verified nevertheless
+                long round_gain = 0;
+                for( unsigned i = 0; i < units.size(); i++) {
+                        if( units[i].truncated ) truncated_units++;
+                        long gain = apply_gain( C, D, perm_rank, units[i], in_unit );
+                        if( gain > 0 ) {
+                                for( unsigned j = 0; j < units[i].tasks.size(); j++) {
+                                        perm_rank[units[i].tasks[j]] = units[i].PEs[units[i].solution[j]];
+                                }
+                                round_gain += gain;
+                        }
+                }
+
+                cur_objective -= round_gain;
+                unsucc_rounds  = round_gain > 0 ? 0 : unsucc_rounds + 1;
+        }
+
+        std::cout <<  "exact group search J(C,D,Pi) = " <<  cur_objective <<  " (was " <<  input_objective << ")" << std::endl;
+        if( truncated_units > 0 ) {
+                std::cout <<  "exact group search: " <<  truncated_units <<  " units not solved to optimality (branch node limit)"  << std::endl;
+        }
+        run_report::count("exact_units_truncated", truncated_units);
+}
+
+void exact_group_mapping::build_units( PartitionConfig & config, graph_access & C, std::vector< NodeID > & perm_rank,
+                                       unsigned offset, std::vector< mapping_unit > & units) {
+        NodeID group_size   = config.group_sizes[0];
+        NodeID fanout       = config.group_sizes[1];
+        NodeID num_parents  = C.number_of_nodes() / (group_size*fanout);
+        NodeID tasks_per_group = std::min(group_size, (NodeID) std::max(1, config.exact_group_max_tasks / 2));
+
+        std::vector< NodeID > task_on_PE(C.number_of_nodes());
+        forall_nodes(C, node) {
+                task_on_PE[perm_rank[node]] = node;
+        } endfor
+
+        std::vector< std::pair< long, NodeID > > candidates;
+        for( NodeID parent = 0; parent < num_parents; parent++) {
+        for( NodeID child = offset; child + 1 < fanout; child += 2) {
+                mapping_unit unit;
+                NodeID groups[2] = {parent*fanout + child, parent*fanout + child + 1};
+                for( unsigned side = 0; side < 2; side++) {
+                        // prefer tasks that communicate much with the other group and little with their own
+                        candidates.clear();
+                        for( NodeID PE = groups[side]*group_size; PE < (groups[side]+1)*group_size; PE++) {
+                                NodeID task = task_on_PE[PE];
+                                long score  = 0;
+                                forall_out_edges(C, e, task) {
+                                        NodeID target_group = perm_rank[C.getEdgeTarget(e)] / group_size;
+                                        if( target_group == groups[1-side] ) score += C.getEdgeWeight(e);
+                                        else if( target_group == groups[side] ) score -= C.getEdgeWeight(e);
+                                } endfor
+                                candidates.push_back( std::pair< long, NodeID >(-score, task) );
+                        }
+                        std::sort(candidates.begin(), candidates.end());
+                        for( unsigned i = 0; i < tasks_per_group; i++) {
+                                unit.tasks.push_back(candidates[i].second);
+                                unit.PEs.push_back(perm_rank[candidates[i].second]);
+                        }
+                }
+                units.push_back(unit);
+        }
+        }
+}
+
+void exact_group_mapping::solve_unit( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank,
+                                      mapping_unit & unit) {
+        unsigned size = unit.tasks.size();
+        unit.truncated = false;
+        unit.solution.resize(size);
+        for( unsigned i = 0; i < size; i++) {
+                unit.solution[i] = i;
+        }
+        if( size < 2 ) return;
+
+        // lin[i][j]: cost of the edges leaving the unit if task i is placed on PE j
+        // W[i][j]:   communication between task i and j of the unit
+        std::vector< std::vector< long > > lin(size, std::vector< long >(size, 0));
+        std::vector< std::vector< long > > W(size, std::vector< long >(size, 0));
+        std::vector< std::vector< long > > DU(size, std::vector< long >(size, 0));
+        for( unsigned j = 0; j < size; j++) {
+                for( unsigned l = 0; l < size; l++) {
+                        DU[j][l] = D.get_xy(unit.PEs[j], unit.PEs[l]);
+                }
+        }
+
+        for( unsigned i = 0; i < size; i++) {
+                forall_out_edges(C, e, unit.tasks[i]) {
+                        NodeID target = C.getEdgeTarget(e);
+                        unsigned local = std::find(unit.tasks.begin(), unit.tasks.end(), target) - unit.tasks.begin();
+                        if( local < size ) {
+                                W[i][local] += C.getEdgeWeight(e);
+                        } else {
+                                for( unsigned j = 0; j < size; j++) {
+                                        lin[i][j] += C.getEdgeWeight(e)*D.get_xy(unit.PEs[j], perm_rank[target]);
+                                }
+                        }
+                } endfor
+        }
+
+        // PEs that are indistinguishable for this unit form a class, only the first free PE of a class is tried
+        std::vector< unsigned > PE_class(size);
+        for( unsigned j = 0; j < size; j++) {
+                PE_class[j] = j;
+                for( unsigned l = 0; l < j; l++) {
+                        if( PE_class[l] != l ) continue;
+
+                        bool equal = DU[j][l] == DU[l][j];
+                        for( unsigned x = 0; x < size && equal; x++) {
+                                if( lin[x][j] != lin[x][l] ) equal = false;
+                                if( x != j && x != l && DU[j][x] != DU[l][x] ) equal = false;
+                        }
+                        if( equal ) {
+                                PE_class[j] = l;
+                                break;
+                        }
+                }
+        }
+
+        // branch on heavy tasks first
+        std::vector< unsigned > order(size);
+        std::vector< long > volume(size, 0);
+        for( unsigned i = 0; i < size; i++) {
+                order[i] = i;
+                for( unsigned j = 0; j < size; j++) volume[i] += W[i][j];
+        }
+        std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return volume[a] > volume[b]; });
+
+        // the current assignment is the initial upper bound
+        long best_cost = 0;
+        for( unsigned i = 0; i < size; i++) {
+                best_cost += lin[i][i];
+                for( unsigned l = 0; l < i; l++) best_cost += W[i][l]*DU[i][l];
+        }
+
+        std::vector< unsigned > assignment(size, size);
+        std::vector< bool > PE_used(size, false);
+        std::vector< long > partial_cost(size+1, 0);
+        std::vector< unsigned > next_PE(size+1, 0);
+        unsigned depth          = 0;
+        unsigned branch_nodes   = 0;
+
+        // iterative depth first search, next_PE[depth] is the next PE to try for task order[depth]
+        while( true ) {
+                if( depth == size ) {
+                        if( partial_cost[depth] < best_cost ) {
+                                best_cost = partial_cost[depth];
+                                for( unsigned i = 0; i < size; i++) unit.solution[i] = assignment[i];
+                        }
+                        depth--;
+                        PE_used[assignment[order[depth]]] = false;
+                        continue;
+                }
+
+                unsigned task = order[depth];
+                unsigned PE   = next_PE[depth];
+                while( PE < size ) {
+                        bool admissible = !PE_used[PE];
+                        for( unsigned l = 0; l < PE && admissible; l++) {
+                                if( PE_class[l] == PE_class[PE] && !PE_used[l] ) admissible = false;
+                        }
+                        if( admissible ) break;
+                        PE++;
+                }
+
+                if( PE < size && ++branch_nodes > EXACT_MAX_BRANCH_NODES ) {
+                        unit.truncated = true;
+                        break;
+                }
+                if( PE == size ) {
+                        if( depth == 0 ) break;
+                        next_PE[depth] = 0;
+                        depth--;
+                        PE_used[assignment[order[depth]]] = false;
+                        continue;
+                }
+                next_PE[depth] = PE + 1;
+
+                long cost = partial_cost[depth] + lin[task][PE];
+                for( unsigned d = 0; d < depth; d++) {
+                        cost += W[task][order[d]]*DU[PE][assignment[order[d]]];
+                }
+
+                // lower bound: every remaining task is placed on its cheapest free PE w.r.t. the fixed tasks
+                long bound = cost;
+                PE_used[PE] = true;
+                assignment[task] = PE;
+                for( unsigned r = depth+1; r < size && bound < best_cost; r++) {
+                        unsigned rtask = order[r];
+                        long min_cost  = std::numeric_limits< long >::max();
+                        for( unsigned j = 0; j < size; j++) {
+                                if( PE_used[j] ) continue;
+                                long cur_cost = lin[rtask][j];
+                                for( unsigned d = 0; d <= depth; d++) {
+                                        cur_cost += W[rtask][order[d]]*DU[j][assignment[order[d]]];
+                                }
+                                min_cost = std::min(min_cost, cur_cost);
+                        }
+                        bound += min_cost;
+                }
+
+                if( bound >= best_cost ) {
+                        PE_used[PE] = false;
+                        continue;
+                }
+
+                partial_cost[depth+1] = cost;
+                depth++;
+                next_PE[depth] = 0;
+        }
+}
+
+long exact_group_mapping::apply_gain( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, mapping_unit & unit,
+                                      std::vector< bool > & in_unit) {
+        for( NodeID task : unit.tasks ) in_unit[task] = true;
+
+        // J counts every edge in both directions, edges inside of the unit are visited twice below
+        long gain = 0;
+        for( unsigned i = 0; i < unit.tasks.size(); i++) {
+                NodeID task   = unit.tasks[i];
+                NodeID old_PE = perm_rank[task];
+                NodeID new_PE = unit.PEs[unit.solution[i]];
+                forall_out_edges(C, e, task) {
+                        NodeID target = C.getEdgeTarget(e);
+                        if( in_unit[target] ) {
+                                unsigned local   = std::find(unit.tasks.begin(), unit.tasks.end(), target) - unit.tasks.begin();
+                                NodeID new_PE_target = unit.PEs[unit.solution[local]];
+                                gain += C.getEdgeWeight(e)*((long)D.get_xy(old_PE, perm_rank[target]) - D.get_xy(new_PE, new_PE_target));
+                        } else {
+                                gain += 2*C.getEdgeWeight(e)*((long)D.get_xy(old_PE, perm_rank[target]) - D.get_xy(new_PE, perm_rank[target]));
+                        }
+                } endfor
+        }
+
+        for( NodeID task : unit.tasks ) in_unit[task] = false;
+        return gain;
+}
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * exact_group_mapping.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef EXACT_GROUP_MAPPING_P2W6DLC8
+#define EXACT_GROUP_MAPPING_P2W6DLC8
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/matrix.h"
+#include "partition_config.h"
+#include "tools/quality_metrics.h"
+
+// a unit is a small set of tasks together with the PEs they occupy.
+// units are taken from two sibling groups of the lowest hierarchy level,
+// hence moving tasks inside a unit does not change distances seen from outside of it
+// and all units can be solved independently.
+struct mapping_unit {
+        std::vector< NodeID > tasks;
+        std::vector< NodeID > PEs;
+        std::vector< NodeID > solution; // tasks[i] is assigned to PEs[solution[i]]
+        bool truncated;                 // the search hit EXACT_MAX_BRANCH_NODES, solution may not be optimal
+};
+
+class exact_group_mapping {
+public:
+        exact_group_mapping();
+        virtual ~exact_group_mapping();
+
+        // input a valid mapping
+        // output a mapping in which no unit can be improved by permuting its tasks
+        void perform_refinement( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+private:
+        void build_units( PartitionConfig & config, graph_access & C, std::vector< NodeID > & perm_rank,
+                          unsigned offset, std::vector< mapping_unit > & units);
+
+        // branch and bound over all assignments of the tasks of the unit to its PEs
+        void solve_unit( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank,
+                         mapping_unit & unit);
+
+        // change of J(C,D,perm_rank) if the solution of the unit is applied
+        long apply_gain( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, mapping_unit & unit,
+                         std::vector< bool > & in_unit);
+
+        quality_metrics qm;
+};
+
+
+#endif /* end of include guard: EXACT_GROUP_MAPPING_P2W6DLC8 */
@@ -23,9 +23,11 @@
 
 #include "balance_configuration.h"
 #include "graph_partitioner.h"
+#include "run_report.h"
 #include "configuration.h"
 #include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
 #include "fast_construct_mapping.h"
+#include "tools/null_buffer.h"
 #include "tools/graph_extractor.h"
 
 fast_construct_mapping::fast_construct_mapping() {
@@ -128,10 +130,10 @@ void fast_construct_mapping::construct_initial_mapping_topdown_internal( Partiti
 }
 
 void fast_construct_mapping::partition_C_perfectly_balanced( PartitionConfig & config, graph_access & C, PartitionID blocks) {
-        std::streambuf* backup = std::cout.rdbuf();
-        std::ofstream ofs;
-        ofs.open("/dev/null");
-        std::cout.rdbuf(ofs.rdbuf()); 
+        report_phase rp("partition");
+        run_report::count("partitioner_invocations");
+
+        silence_output silence;
 
         PartitionConfig partition_config = config;
         configuration cfg; 
@@ -163,7 +165,9 @@ void fast_construct_mapping::partition_C_perfectly_balanced( PartitionConfig & c
         balance_configuration bc;
         bc.configurate_balance( partition_config, C);
 
+        run_report::begin_phase("perform_partitioning");
         partitioner.perform_partitioning(partition_config, C);
+        run_report::end_phase();
 
         complete_boundary boundary(&C);
         boundary.build();
@@ -176,7 +180,4 @@ void fast_construct_mapping::partition_C_perfectly_balanced( PartitionConfig & c
         forall_nodes(C, node) {
                 C.setNodeWeight(node, weights[node]);
         } endfor
-
-        ofs.close();
-        std::cout.rdbuf(backup);
 }
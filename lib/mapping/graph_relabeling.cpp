@@ -0,0 +1,137 @@
+/******************************************************************************
+ * graph_relabeling.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <queue>
+
+#include "graph_relabeling.h"
+
+graph_relabeling::graph_relabeling() {
+
+}
+
+graph_relabeling::~graph_relabeling() {
+
+}
+
+void graph_relabeling::compute_order( PartitionConfig & config, graph_access & C, 
+                                      std::vector< NodeID > & perm_rank, 
+                                      std::vector< NodeID > & new_to_old) {
+        switch( config.relabeling ) {
+                case RELABEL_RCM:
+                        rcm_order( C, new_to_old );
+                        break;
+                case RELABEL_MAPPING:
+                        mapping_order( C, perm_rank, new_to_old );
+                        break;
+                default:
+                        new_to_old.resize(C.number_of_nodes());
+                        forall_nodes(C, node) {
+                                new_to_old[node] = node;
+                        } endfor
+        }
+}
+
+void graph_relabeling::rcm_order( graph_access & C, std::vector< NodeID > & new_to_old) {
+        new_to_old.clear();
+        new_to_old.reserve(C.number_of_nodes());
+
+        std::vector< NodeID > by_degree(C.number_of_nodes());
+        forall_nodes(C, node) {
+                by_degree[node] = node;
+        } endfor
+        std::stable_sort( by_degree.begin(), by_degree.end(), [&]( const NodeID & lhs, const NodeID & rhs ) {
+                        return C.getNodeDegree(lhs) < C.getNodeDegree(rhs);
+        });
+
+        std::vector< bool > visited(C.number_of_nodes(), false);
+        std::vector< NodeID > neighbors;
+        for( NodeID start : by_degree ) {
+                if( visited[start] ) continue;
+
+                std::queue< NodeID > bfsqueue;
+                bfsqueue.push(start);
+                visited[start] = true;
+                while( !bfsqueue.empty() ) {
+                        NodeID node = bfsqueue.front();
+                        bfsqueue.pop();
+                        new_to_old.push_back(node);
+
+                        neighbors.clear();
+                        forall_out_edges(C, e, node) {
+                                NodeID target = C.getEdgeTarget(e);
+                                if( !visited[target] ) {
+                                        visited[target] = true;
+                                        neighbors.push_back(target);
+                                }
+                        } endfor
+                        std::stable_sort( neighbors.begin(), neighbors.end(), [&]( const NodeID & lhs, const NodeID & rhs ) {
+                                        return C.getNodeDegree(lhs) < C.getNodeDegree(rhs);
+                        });
+                        for( NodeID target : neighbors ) {
+                                bfsqueue.push(target);
+                        }
+                }
+        }
+
+        std::reverse( new_to_old.begin(), new_to_old.end() );
+}
+
+void graph_relabeling::mapping_order( graph_access & C, std::vector< NodeID > & perm_rank, 
+                                      std::vector< NodeID > & new_to_old) {
+        // perm_rank is a permutation, hence the order is the inverse permutation
+        new_to_old.resize(C.number_of_nodes());
+        forall_nodes(C, node) {
+                new_to_old[perm_rank[node]] = node;
+        } endfor
+}
+
+void graph_relabeling::relabel( graph_access & C, std::vector< NodeID > & perm_rank, 
+                                std::vector< NodeID > & new_to_old,
+                                graph_access & C_new, std::vector< NodeID > & perm_rank_new) {
+        std::vector< NodeID > old_to_new(C.number_of_nodes());
+        for( NodeID new_id = 0; new_id < new_to_old.size(); new_id++) {
+                old_to_new[new_to_old[new_id]] = new_id;
+        }
+
+        perm_rank_new.resize(C.number_of_nodes());
+        C_new.start_construction(C.number_of_nodes(), C.number_of_edges());
+        for( NodeID new_id = 0; new_id < new_to_old.size(); new_id++) {
+                NodeID node = new_to_old[new_id];
+                NodeID shadow = C_new.new_node();
+                C_new.setNodeWeight(shadow, C.getNodeWeight(node));
+                perm_rank_new[new_id] = perm_rank[node];
+
+                forall_out_edges(C, e, node) {
+                        EdgeID shadow_edge = C_new.new_edge(shadow, old_to_new[C.getEdgeTarget(e)]);
+                        C_new.setEdgeWeight(shadow_edge, C.getEdgeWeight(e));
+                } endfor
+        }
+        C_new.finish_construction();
+}
+
+void graph_relabeling::map_back( std::vector< NodeID > & perm_rank_new, 
+                                 std::vector< NodeID > & new_to_old,
+                                 std::vector< NodeID > & perm_rank) {
+        for( NodeID new_id = 0; new_id < new_to_old.size(); new_id++) {
+                perm_rank[new_to_old[new_id]] = perm_rank_new[new_id];
+        }
+}
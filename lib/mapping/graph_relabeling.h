@@ -0,0 +1,62 @@
+/******************************************************************************
+ * graph_relabeling.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef GRAPH_RELABELING_9PX3VL6C
+#define GRAPH_RELABELING_9PX3VL6C
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+// renumbers the communication graph such that adjacent tasks get close ids, i.e. the
+// accesses to perm_rank, node_contribution and the rows of D during local search are
+// mostly to nearby memory. new_to_old[new_id] is the original id of a task.
+class graph_relabeling {
+        public:
+                graph_relabeling();
+                virtual ~graph_relabeling();
+
+                // order according to config.relabeling
+                void compute_order( PartitionConfig & config, graph_access & C, 
+                                    std::vector< NodeID > & perm_rank, 
+                                    std::vector< NodeID > & new_to_old);
+
+                // builds the relabeled graph C_new and the corresponding mapping perm_rank_new
+                void relabel( graph_access & C, std::vector< NodeID > & perm_rank, 
+                              std::vector< NodeID > & new_to_old,
+                              graph_access & C_new, std::vector< NodeID > & perm_rank_new);
+
+                // writes the mapping of the relabeled graph back to the original ids
+                void map_back( std::vector< NodeID > & perm_rank_new, 
+                               std::vector< NodeID > & new_to_old,
+                               std::vector< NodeID > & perm_rank);
+
+        private:
+                // reverse cuthill-mckee, each component is started at a node of minimum degree
+                void rcm_order( graph_access & C, std::vector< NodeID > & new_to_old);
+
+                // tasks sorted by the PE they are mapped to
+                void mapping_order( graph_access & C, std::vector< NodeID > & perm_rank, 
+                                    std::vector< NodeID > & new_to_old);
+};
+
+#endif /* end of include guard: GRAPH_RELABELING_9PX3VL6C */
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * hierarchy_partitioning.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <math.h>
+
+#include "balance_configuration.h"
+#include "graph_partitioner.h"
+#include "hierarchy_partitioning.h"
+#include "tools/graph_extractor.h"
+#include "tools/null_buffer.h"
+
+hierarchy_partitioning::hierarchy_partitioning() {
+
+}
+
+hierarchy_partitioning::~hierarchy_partitioning() {
+
+}
+
+void hierarchy_partitioning::perform_partitioning( PartitionConfig & config, graph_access & G) {
+        int levels = 0;
+        for( unsigned i = 0; i < config.group_sizes.size(); i++) {
+                if( config.group_sizes[i] > 1 ) levels++;
+        }
+        levels = std::max(levels, 1);
+        m_level_imbalance = 100*(pow(1 + config.imbalance/100.0, 1.0/levels) - 1);
+
+        std::vector< NodeID > map_to_original(G.number_of_nodes());
+        forall_nodes(G, node) {
+                map_to_original[node] = node;
+        } endfor
+
+        std::vector< PartitionID > partition(G.number_of_nodes(), 0);
+        perform_partitioning_internal( config, G, config.group_sizes, 0, map_to_original, partition);
+
+        G.set_partition_count(config.k);
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, partition[node]);
+        } endfor
+}
+
+void hierarchy_partitioning::perform_partitioning_internal( PartitionConfig & config, graph_access & G, 
+                                                            std::vector< int > group_sizes, PartitionID start_id,
+                                                            std::vector< NodeID > & map_to_original,
+                                                            std::vector< PartitionID > & partition) {
+        PartitionID num_parts = group_sizes[group_sizes.size()-1];
+        group_sizes.pop_back();
+        if( num_parts == 1 && group_sizes.size() > 0 ) {
+                return perform_partitioning_internal( config, G, group_sizes, start_id, map_to_original, partition);
+        }
+
+        PartitionID blocks_per_part = 1;
+        for( unsigned i = 0; i < group_sizes.size(); i++) {
+                blocks_per_part *= group_sizes[i];
+        }
+
+        if( num_parts > 1 && G.number_of_nodes() > 1 ) {
+                silence_output silence;
+
+                PartitionConfig level_config   = config;
+                level_config.k                 = num_parts;
+                level_config.imbalance         = config.imbalance == 0 ? 0 : m_level_imbalance;
+                level_config.balance_edges     = false; // already included in the node weights of the input graph
+
+                G.set_partition_count(num_parts);
+                balance_configuration bc;
+                bc.configurate_balance( level_config, G);
+
+                graph_partitioner partitioner;
+                partitioner.perform_partitioning( level_config, G);
+        } else {
+                G.set_partition_count(1);
+                forall_nodes(G, node) {
+                        G.setPartitionIndex(node, 0);
+                } endfor
+        }
+
+        if( group_sizes.size() == 0 ) {
+                forall_nodes(G, node) {
+                        partition[map_to_original[node]] = start_id + G.getPartitionIndex(node);
+                } endfor
+                return;
+        }
+
+        for( PartitionID block = 0; block < num_parts; block++) {
+                graph_extractor ge; graph_access Q;
+                std::vector<NodeID> mapping;
+                ge.extract_block( G, Q, block, mapping);
+
+                forall_nodes(Q, node) {
+                        mapping[node] = map_to_original[mapping[node]];
+                } endfor
+
+                perform_partitioning_internal( config, Q, group_sizes, start_id + block*blocks_per_part, mapping, partition);
+        }
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * hierarchy_partitioning.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef HIERARCHY_PARTITIONING_4KD8WQ2N
+#define HIERARCHY_PARTITIONING_4KD8WQ2N
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+// partitions the application graph recursively along the system hierarchy, i.e. first
+// into the top level groups (e.g. nodes), then each of them into the next level (e.g. sockets) ...
+// the block ids follow the PE numbering of the hierarchical distance matrix, hence the most
+// expensive links are cut least and the identity is already a good mapping of the blocks.
+class hierarchy_partitioning {
+        public:
+                hierarchy_partitioning();
+                virtual ~hierarchy_partitioning();
+
+                void perform_partitioning( PartitionConfig & config, graph_access & G);
+
+        private:
+                void perform_partitioning_internal( PartitionConfig & config, graph_access & G, 
+                                                    std::vector< int > group_sizes, PartitionID start_id,
+                                                    std::vector< NodeID > & map_to_original,
+                                                    std::vector< PartitionID > & partition);
+
+                // imbalance per level, such that the levels together respect config.imbalance
+                double m_level_imbalance;
+};
+
+#endif /* end of include guard: HIERARCHY_PARTITIONING_4KD8WQ2N */
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * incremental_search_space.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <queue>
+
+#include "incremental_search_space.h"
+
+incremental_search_space::incremental_search_space(PartitionConfig & config, NodeID number_of_nodes) {
+        // a small neighborhood keeps the work local to the change
+        m_search_depth = std::min(2, config.communication_neighborhood_dist);
+        m_depth.resize(number_of_nodes, -1);
+        C = NULL;
+}
+
+incremental_search_space::~incremental_search_space() {
+
+}
+
+void incremental_search_space::set_graph_ref( graph_access * C ) {
+        this->C = C;
+}
+
+void incremental_search_space::set_changed_nodes( std::vector< NodeID > & changed_nodes ) {
+        for( NodeID node : changed_nodes ) {
+                activate_neighborhood( node );
+        }
+}
+
+void incremental_search_space::activate_neighborhood( NodeID node ) {
+        std::queue< NodeID > bfsqueue;
+        bfsqueue.push(node);
+        m_depth[node] = 0;
+        m_touched.clear();
+        m_touched.push_back(node);
+
+        while( !bfsqueue.empty() ) {
+                NodeID v = bfsqueue.front();
+                bfsqueue.pop();
+                if( m_depth[v] == m_search_depth ) continue;
+
+                forall_out_edges((*C), e, v) {
+                        NodeID target = C->getEdgeTarget(e);
+                        if( m_depth[target] == -1 ) {
+                                m_depth[target] = m_depth[v] + 1;
+                                bfsqueue.push(target);
+                                m_touched.push_back(target);
+                                activate_pair( node, target );
+                        }
+                } endfor
+        }
+
+        for( NodeID v : m_touched ) {
+                m_depth[v] = -1;
+        }
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * incremental_search_space.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef INCREMENTAL_SEARCH_SPACE_C8TQ2MZE
+#define INCREMENTAL_SEARCH_SPACE_C8TQ2MZE
+
+#include <deque>
+#include <stdint.h>
+#include <unordered_set>
+#include <utility>
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+// search space for remapping after the communication graph changed.
+// initially only pairs around changed tasks are active, a successful swap
+// activates the pairs around the two swapped tasks (as with active pairs in
+// communication_graph_search_space). the search is done when no pair is active,
+// hence the work is proportional to the size of the change.
+class incremental_search_space {
+        public:
+                incremental_search_space(PartitionConfig & config, NodeID number_of_nodes);
+                virtual ~incremental_search_space();
+
+                void set_graph_ref( graph_access * C );
+
+                // has to be called after set_graph_ref
+                void set_changed_nodes( std::vector< NodeID > & changed_nodes );
+
+                bool done() {
+                        return m_active_pairs.empty();
+                }; // are we done?
+
+                void commit_status( bool success ) {
+                        if( success ) {
+                                activate_neighborhood( m_last_pair.first );
+                                activate_neighborhood( m_last_pair.second );
+                        }
+                }
+
+                std::pair< NodeID, NodeID > nextPair() {
+                        m_last_pair = m_active_pairs.front();
+                        m_active_pairs.pop_front();
+                        m_pair_active.erase( key( m_last_pair.first, m_last_pair.second ) );
+                        return m_last_pair;
+                }
+
+        private:
+                // activates all pairs of node with tasks at most m_search_depth hops away
+                void activate_neighborhood( NodeID node );
+
+                void activate_pair( NodeID lhs, NodeID rhs ) {
+                        if( lhs == rhs ) return;
+                        if( m_pair_active.insert( key(lhs, rhs) ).second ) {
+                                m_active_pairs.push_back( std::pair< NodeID, NodeID >(lhs, rhs) );
+                        }
+                }
+
+                static uint64_t key( NodeID lhs, NodeID rhs ) {
+                        if( lhs > rhs ) std::swap(lhs, rhs);
+                        return ((uint64_t) lhs << 32) | rhs;
+                }
+
+                std::deque< std::pair< NodeID, NodeID > > m_active_pairs;
+                std::unordered_set< uint64_t > m_pair_active;
+                std::pair< NodeID, NodeID > m_last_pair;
+                std::vector< int > m_depth;
+                std::vector< NodeID > m_touched;
+                int m_search_depth;
+
+                graph_access * C;
+};
+
+
+#endif /* end of include guard: INCREMENTAL_SEARCH_SPACE_C8TQ2MZE */
@@ -19,6 +19,10 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  *****************************************************************************/
 
+#include <fstream>
+#include <stdio.h>
+
+#include "graph_io.h"
 #include "tools/quality_metrics.h"
 #include "tools/random_functions.h"
 #include "tools/timer.h"
@@ -27,6 +31,11 @@
 #include "communication_graph_search_space.h"
 
 local_search_mapping::local_search_mapping() {
+        m_original_ids = NULL;
+        m_swaps_evaluated = 0;
+        m_swaps_performed = 0;
+        m_pairs_skipped   = 0;
+        m_trace_next      = 0;
 
 }
 
@@ -35,89 +44,130 @@ local_search_mapping::~local_search_mapping() {
 }
 
 
-bool local_search_mapping::perform_single_swap(graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs) {
-        NodeWeight old_volume      = total_volume;
-        NodeWeight old_lhs_contrib = node_contribution[swap_lhs];
-        NodeWeight old_rhs_contrib = node_contribution[swap_rhs];
+void local_search_mapping::initialize( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        total_volume = 0;
+        node_contribution.assign(C.number_of_nodes(), 0); // the object may be reused for several graphs
+        m_edge_distance.resize(C.number_of_edges());
+        m_new_distance.resize(C.number_of_edges());
+        forall_nodes(C, node) {
+                forall_out_edges(C, e, node) {
+                        NodeID target              = C.getEdgeTarget(e);
+                        NodeWeight comm_vol        = C.getEdgeWeight(e);
+                        m_edge_distance[e]         = D.get_xy(perm_rank[node], perm_rank[target]);
+                        node_contribution[ node ] += comm_vol*m_edge_distance[e];
+                } endfor
+                total_volume += node_contribution[node]; 
+        } endfor
 
-        // we multiply by two since contributions are on both sides
-        total_volume -= 2*node_contribution[swap_lhs];
-        total_volume -= 2*node_contribution[swap_rhs];
+        // reverse edges: bucket the edges by target, the bucket of node then holds its incoming edges
+        std::vector< EdgeID > in_start(C.number_of_nodes()+1, 0);
+        std::vector< EdgeID > in_edges(C.number_of_edges());
+        forall_nodes(C, node) {
+                forall_out_edges(C, e, node) {
+                        in_start[C.getEdgeTarget(e)+1]++;
+                } endfor
+        } endfor
+        for( NodeID node = 0; node < C.number_of_nodes(); node++) {
+                in_start[node+1] += in_start[node];
+        }
+        std::vector< EdgeID > pos(in_start.begin(), in_start.end()-1);
+        forall_nodes(C, node) {
+                forall_out_edges(C, e, node) {
+                        in_edges[pos[C.getEdgeTarget(e)]++] = e;
+                } endfor
+        } endfor
 
-        // fix adjacent candiates
-        forall_out_edges(C, e, swap_lhs) {
-                NodeID target = C.getEdgeTarget(e);
-                if( target == swap_rhs ) {
-                        NodeWeight comm_vol     = C.getEdgeWeight(e);
-                        NodeID perm_rank_node   = perm_rank[swap_lhs];
-                        NodeID perm_rank_target = perm_rank[swap_rhs];
-                        NodeWeight cur_vol      = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
-                        total_volume += 2*cur_vol;
-                        break;
+        // C is undirected, i.e. every edge has a reverse edge
+        m_reverse_edge.resize(C.number_of_edges());
+        std::vector< EdgeID > incoming_from(C.number_of_nodes(), 0);
+        std::vector< NodeID > source(C.number_of_edges());
+        forall_nodes(C, node) {
+                forall_out_edges(C, e, node) {
+                        source[e] = node;
+                } endfor
+        } endfor
+        forall_nodes(C, node) {
+                for( EdgeID i = in_start[node]; i < in_start[node+1]; i++) {
+                        incoming_from[source[in_edges[i]]] = in_edges[i];
                 }
+                forall_out_edges(C, e, node) {
+                        m_reverse_edge[e] = incoming_from[C.getEdgeTarget(e)];
+                } endfor
         } endfor
+}
 
-        node_contribution[swap_lhs] = 0;
-        node_contribution[swap_rhs] = 0;
-
-        std::swap(perm_rank[swap_lhs], perm_rank[swap_rhs]);
-        update_node_contribution( C, D, perm_rank, swap_lhs, swap_rhs );
-
-        total_volume += 2*node_contribution[swap_lhs]; 
-        total_volume += 2*node_contribution[swap_rhs]; 
-
-        // fix adjacent candiates
-        forall_out_edges(C, e, swap_lhs) {
+long local_search_mapping::move_gain( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID node, NodeID PE, NodeID skip_target) {
+        long delta = 0;
+        forall_out_edges(C, e, node) {
                 NodeID target = C.getEdgeTarget(e);
-                if( target == swap_rhs ) {
-                        NodeWeight comm_vol     = C.getEdgeWeight(e);
-                        NodeID perm_rank_node   = perm_rank[swap_lhs];
-                        NodeID perm_rank_target = perm_rank[swap_rhs];
-                        NodeWeight cur_vol      = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
-                        total_volume -= 2*cur_vol;
-                        break;
+                if( target == skip_target ) continue; // the distance of the swapped pair does not change
+                m_new_distance[e] = D.get_xy(PE, perm_rank[target]);
+                delta += (long)C.getEdgeWeight(e) * (m_new_distance[e] - m_edge_distance[e]);
+        } endfor
+        return delta;
+}
+
+void local_search_mapping::commit_move( graph_access & C, NodeID node, NodeID skip_target) {
+        NodeWeight contribution = 0;
+        forall_out_edges(C, e, node) {
+                NodeID target       = C.getEdgeTarget(e);
+                NodeWeight comm_vol = C.getEdgeWeight(e);
+                if( target != skip_target ) {
+                        node_contribution[target] += comm_vol*m_new_distance[e];
+                        node_contribution[target] -= comm_vol*m_edge_distance[e];
+                        m_edge_distance[e]                  = m_new_distance[e];
+                        m_edge_distance[m_reverse_edge[e]]  = m_new_distance[e];
                 }
+                contribution += comm_vol*m_edge_distance[e];
         } endfor
+        node_contribution[node] = contribution;
+}
 
-        if( total_volume < old_volume ) {
-                PRINT(std::cout <<  "log> improvement " <<  total_volume <<  " " <<  old_volume << std::endl;)
+bool local_search_mapping::perform_single_swap(graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs) {
+        // only the distances of edges at the two swapped tasks change, the old ones are cached
+        long delta = move_gain( C, D, perm_rank, swap_lhs, perm_rank[swap_rhs], swap_rhs );
+        delta     += move_gain( C, D, perm_rank, swap_rhs, perm_rank[swap_lhs], swap_lhs );
+
+        if( delta < 0 ) {
+                // we multiply by two since contributions are on both sides
+                PRINT(std::cout <<  "log> improvement " <<  total_volume + 2*delta <<  " " <<  total_volume << std::endl;)
+                total_volume += 2*delta;
+                std::swap(perm_rank[swap_lhs], perm_rank[swap_rhs]);
+                commit_move( C, swap_lhs, swap_rhs );
+                commit_move( C, swap_rhs, swap_lhs );
                 return true;
         } else {
-                std::swap(perm_rank[swap_lhs], perm_rank[swap_rhs]);
-                update_node_contribution( C, D, perm_rank, swap_lhs, swap_rhs );
-                node_contribution[swap_lhs] = old_lhs_contrib;
-                node_contribution[swap_rhs] = old_rhs_contrib;
-                total_volume = old_volume;
                 return false;
         }
 }
 
-void local_search_mapping::update_node_contribution( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs) {
-        forall_out_edges(C, e, swap_lhs) {
-                NodeID target                   = C.getEdgeTarget(e);
-                NodeWeight comm_vol             = C.getEdgeWeight(e);
-                NodeID perm_rank_node           = perm_rank[swap_lhs];
-                NodeID perm_rank_target         = perm_rank[target];
-                NodeWeight cur_vol              = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
-                node_contribution[ swap_lhs ]  += cur_vol;
-
-                // update adjacent node contrib
-                if( target != swap_rhs) {
-                        node_contribution[ target ] -= comm_vol*D.get_xy(perm_rank[swap_rhs], perm_rank_target);
-                        node_contribution[ target ] += cur_vol;
+void local_search_mapping::write_checkpoint( PartitionConfig & config, std::vector< NodeID > & perm_rank) {
+        std::string tmp_filename = config.checkpoint_filename + ".tmp";
+        if( m_original_ids != NULL ) {
+                std::vector< NodeID > original_perm_rank(perm_rank.size());
+                for( unsigned node = 0; node < perm_rank.size(); node++) {
+                        original_perm_rank[(*m_original_ids)[node]] = perm_rank[node];
                 }
-        } endfor
-        forall_out_edges(C, e, swap_rhs) {
-                NodeID target                   = C.getEdgeTarget(e);
-                NodeWeight comm_vol             = C.getEdgeWeight(e);
-                NodeID perm_rank_node           = perm_rank[swap_rhs];
-                NodeID perm_rank_target         = perm_rank[target];
-                NodeWeight cur_vol              = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
-                node_contribution[ swap_rhs ]  += cur_vol;
-
-                if( target != swap_lhs) {
-                        node_contribution[ target ] -= comm_vol*D.get_xy(perm_rank[swap_lhs], perm_rank_target);
-                        node_contribution[ target ] += cur_vol;
-                }
-        } endfor
+                graph_io::writeVector( original_perm_rank, tmp_filename );
+        } else {
+                graph_io::writeVector( perm_rank, tmp_filename );
+        }
+        if( rename( tmp_filename.c_str(), config.checkpoint_filename.c_str() ) != 0 ) {
+                perror("could not write checkpoint");
+        }
+}
+
+void local_search_mapping::write_trace( PartitionConfig & config ) {
+        std::ofstream f(config.trace_filename.c_str());
+        if( !f ) {
+                std::cout <<  "could not write trace to " <<  config.trace_filename  << std::endl;
+                return;
+        }
+
+        f << "time,swaps_attempted,swaps_accepted,objective" << std::endl;
+        unsigned long long first = m_trace_next > LS_TRACE_CAPACITY ? m_trace_next - LS_TRACE_CAPACITY : 0;
+        for( unsigned long long i = first; i < m_trace_next; i++) {
+                trace_sample & sample = m_trace[i % LS_TRACE_CAPACITY];
+                f << sample.time << "," << sample.swaps_attempted << "," << sample.swaps_accepted << "," << sample.objective << std::endl;
+        }
 }
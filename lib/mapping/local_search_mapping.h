@@ -27,72 +27,183 @@
 #include "data_structure/matrix/matrix.h"
 #include "tools/timer.h"
 #include "tools/quality_metrics.h"
+#include "qap_lower_bound.h"
+#include "run_report.h"
+
+// number of pairs between two looks at the clock
+#define LS_CLOCK_CHECK_INTERVAL 1024
+
+// number of samples kept by the convergence trace, older samples are overwritten
+#define LS_TRACE_CAPACITY 65536
 
 class local_search_mapping {
 public:
         local_search_mapping();
         virtual ~local_search_mapping();
            
+        // returns false if the objective maintained by the search does not match J(C,D,perm_rank)
+        // at the end, i.e. C is not symmetric
         template < typename search_space > 
-        void perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+        bool perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+        // uses a search space that has already been set up by the caller
+        template < typename search_space > 
+        bool perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, search_space & fss);
+
+        // if C is a relabeled graph, original_ids[node] is the original id of node.
+        // checkpoints are then written w.r.t. the original ids
+        void set_original_ids( std::vector< NodeID > * original_ids ) {
+                m_original_ids = original_ids;
+        }
+
+        // writes perm_rank to a temporary file that is then renamed to config.checkpoint_filename,
+        // hence a reader never sees a partially written checkpoint
+        void write_checkpoint( PartitionConfig & config, std::vector< NodeID > & perm_rank);
+
+        // statistics of the last local search
+        unsigned long long swaps_evaluated() { return m_swaps_evaluated; }
+        unsigned long long swaps_performed() { return m_swaps_performed; }
 
 private:
         bool perform_single_swap(graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
-        void update_node_contribution( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
+
+        // computes node_contribution, total_volume and the distance of every edge
+        void initialize( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+        // change of the contribution of node if it is moved to PE, new distances of its edges
+        // (except to the edge to skip_target) are stored in m_new_distance
+        long move_gain( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID node, NodeID PE, NodeID skip_target);
+
+        // takes the distances of m_new_distance for all edges of node (except to skip_target)
+        void commit_move( graph_access & C, NodeID node, NodeID skip_target);
+
+        // convergence trace, a ring buffer of samples that is written as csv at the end
+        struct trace_sample {
+                double time;
+                unsigned long long swaps_attempted;
+                unsigned long long swaps_accepted;
+                long long objective;
+        };
+
+        void record_sample( double time ) {
+                trace_sample & sample   = m_trace[m_trace_next % LS_TRACE_CAPACITY];
+                sample.time             = time;
+                sample.swaps_attempted  = m_swaps_evaluated;
+                sample.swaps_accepted   = m_swaps_performed;
+                sample.objective        = total_volume;
+                m_trace_next++;
+        }
+
+        void write_trace( PartitionConfig & config );
 
         // Data Members
         std::vector< NodeID > node_contribution;
-        NodeWeight total_volume;
+        long long total_volume;
         quality_metrics qm;
+        std::vector< NodeID > * m_original_ids;
+        unsigned long long m_swaps_evaluated;
+        unsigned long long m_swaps_performed;
+        unsigned long long m_pairs_skipped;
+
+        // current distance of every edge (both directions are kept consistent), avoids
+        // looking up the distances of the unchanged endpoint positions during a swap
+        std::vector< EdgeWeight > m_edge_distance;
+        std::vector< EdgeWeight > m_new_distance;
+        std::vector< EdgeID > m_reverse_edge;
+
+        std::vector< trace_sample > m_trace;
+        unsigned long long m_trace_next;
 };
 
 // input a valid initial mapping
 // output a valid hopefully better mapping
 template < typename search_space > 
-void local_search_mapping::perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+bool local_search_mapping::perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        search_space fss(config, C.number_of_nodes());
+	fss.set_graph_ref( &C);
+
+        return perform_local_search( config, C, D, perm_rank, fss);
+}
+
+template < typename search_space > 
+bool local_search_mapping::perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, search_space & fss) {
         timer_x t; t.restart();
 
         //compute total metric
-        total_volume = 0;
-        node_contribution.resize(C.number_of_nodes(), 0);
-        forall_nodes(C, node) {
-                forall_out_edges(C, e, node) {
-                        NodeID target              = C.getEdgeTarget(e);
-                        NodeWeight comm_vol        = C.getEdgeWeight(e);
-                        NodeID perm_rank_node      = perm_rank[node];
-                        NodeID perm_rank_target    = perm_rank[target];
-                        NodeWeight cur_vol         = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
-                        node_contribution[ node ] += cur_vol;
-                } endfor
-                total_volume += node_contribution[node]; 
-        } endfor
-        std::cout <<  "J(C,D,Pi) = " <<  total_volume << std::endl;
+        initialize( C, D, perm_rank );
+        m_swaps_evaluated = 0;
+        m_swaps_performed = 0;
+        m_pairs_skipped   = 0;
         //std::cout <<  "Diameter " << qm.diameter(C) << std::endl;
 
-        search_space fss(config, C.number_of_nodes());
-	fss.set_graph_ref( &C);
+        // the mapping only improves, i.e. the current mapping is the best so far
+        bool checkpoints = config.checkpoint_filename != "";
+        timer_x checkpoint_t; 
+        unsigned pairs_since_check = 0;
 
+        bool tracing = config.trace_filename != "";
+        unsigned swaps_to_sample = config.trace_interval;
+        if( tracing ) {
+                m_trace.resize(LS_TRACE_CAPACITY);
+                m_trace_next = 0;
+                record_sample( t.elapsed() );
+        }
         while ( !fss.done() ) {
+                if( ++pairs_since_check == LS_CLOCK_CHECK_INTERVAL ) {
+                        pairs_since_check = 0;
+                        if( config.time_limit > 0 && t.elapsed() > config.time_limit ) {
+                                std::cout <<  "local search stopped by time limit"  << std::endl;
+                                break;
+                        }
+                        if( qap_lower_bound::gap_reached( config, total_volume ) ) {
+                                std::cout <<  "local search stopped, gap to lower bound reached"  << std::endl;
+                                break;
+                        }
+                        if( checkpoints && checkpoint_t.elapsed() > config.checkpoint_interval ) {
+                                write_checkpoint( config, perm_rank );
+                                checkpoint_t.restart();
+                        }
+                }
+
                 std::pair< NodeID, NodeID > cur_pair = fss.nextPair();
 
                 NodeID swap_lhs = cur_pair.first;
                 NodeID swap_rhs = cur_pair.second;
 
                 if( D.get_xy(perm_rank[swap_lhs], perm_rank[swap_rhs]) == config.distances[0] ) {
+                        m_pairs_skipped++;
                         fss.commit_status(false);
                         continue; // skipping swaps inside nodes 
                 }
+                m_swaps_evaluated++;
                 if(!perform_single_swap( C, D, perm_rank, swap_lhs, swap_rhs)) {
 			fss.commit_status(false);
                 } else {
+                        m_swaps_performed++;
 			fss.commit_status(true);
 		}
+
+                if( tracing && --swaps_to_sample == 0 ) {
+                        swaps_to_sample = config.trace_interval;
+                        record_sample( t.elapsed() );
+                }
         }
 
         if( total_volume != qm.total_qap(C, D, perm_rank)) {
                 std::cout <<  "objective function mismatch"  << std::endl;
-                exit(0);
+                return false;
+        }
+
+        if( checkpoints ) write_checkpoint( config, perm_rank );
+        if( tracing ) {
+                record_sample( t.elapsed() );
+                write_trace( config );
         }
+
+        run_report::count("swaps_attempted", m_swaps_evaluated);
+        run_report::count("swaps_accepted", m_swaps_performed);
+        run_report::count("pairs_skipped", m_pairs_skipped);
+        return true;
 }
 
 
@@ -23,46 +23,230 @@
 #include "communication_graph_search_space.h"
 #include "construct_distance_matrix.h"
 #include "construct_mapping.h"
+#include "evolutionary_mapping.h"
+#include "exact_group_mapping.h"
 #include "full_search_space.h"
 #include "full_search_space_pruned.h"
+#include "graph_relabeling.h"
+#include "incremental_search_space.h"
 #include "local_search_mapping.h"
 #include "mapping_algorithms.h"
+#include "qap_lower_bound.h"
+#include "run_report.h"
+#include "tabu_search_mapping.h"
 #include "partition/partition_config.h"
 #include "tools/random_functions.h"
 
 mapping_algorithms::mapping_algorithms() {
-
+        m_local_search = new local_search_mapping();
+        m_search_space = NULL;
 }
 
 mapping_algorithms::~mapping_algorithms() {
-
+        delete m_local_search;
+        if( m_search_space != NULL ) delete m_search_space;
 }
 
 
-void mapping_algorithms::construct_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+bool mapping_algorithms::construct_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
         construct_distance_matrix cdm;
-        cdm.construct_matrix( config, D );
+        run_report::begin_phase("distance_matrix");
+        bool success = cdm.construct_matrix( config, D );
+        run_report::end_phase();
+        if( !success ) return false;
+
+        return compute_mapping( config, C, D, perm_rank);
+}
 
+bool mapping_algorithms::compute_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        m_run_t.restart();
         t.restart();
+        qm.set_num_threads(config.num_threads);
         construct_mapping cm;
+        run_report::begin_phase("construction");
         cm.construct_initial_mapping( config, C, D, perm_rank);
+        run_report::end_phase();
         std::cout <<  "construction took " <<  t.elapsed() << std::endl;
+        std::cout <<  "J(C,D,Pi) = " <<  qm.total_qap(C, D, perm_rank) << std::endl;
+
+        compute_lower_bound( config, C );
+        return improve_mapping( config, C, D, perm_rank);
+}
+
+bool mapping_algorithms::resume_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        construct_distance_matrix cdm;
+        run_report::begin_phase("distance_matrix");
+        bool success = cdm.construct_matrix( config, D );
+        run_report::end_phase();
+        if( !success ) return false;
+
+        m_run_t.restart();
+        qm.set_num_threads(config.num_threads);
+        std::cout <<  "resuming, J(C,D,Pi) = " <<  qm.total_qap(C, D, perm_rank) << std::endl;
+        compute_lower_bound( config, C );
+        return improve_mapping( config, C, D, perm_rank);
+}
+
+bool mapping_algorithms::improve_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        // time_limit bounds the whole run, every phase is limited to the time that is left
+        double time_limit = config.time_limit;
+        bool success      = improve_mapping_internal( config, C, D, perm_rank, time_limit);
+        config.time_limit = time_limit;
+        return success;
+}
+
+bool mapping_algorithms::time_left( PartitionConfig & config, double time_limit, const std::string & phase) {
+        if( time_limit <= 0 ) return true;
+
+        config.time_limit = time_limit - m_run_t.elapsed();
+        if( config.time_limit > 0 ) return true;
+
+        std::cout <<  "time limit reached, skipping " <<  phase << std::endl;
+        return false;
+}
+
+bool mapping_algorithms::improve_mapping_internal( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, 
+                                                   double time_limit) {
         t.restart();
+        bool success = true;
+        if( config.relabeling != RELABEL_NONE ) {
+                run_report::begin_phase("relabeling");
+                graph_relabeling gr;
+                graph_access C_new;
+                std::vector< NodeID > new_to_old, perm_rank_new;
+                gr.compute_order( config, C, perm_rank, new_to_old );
+                gr.relabel( C, perm_rank, new_to_old, C_new, perm_rank_new );
+                run_report::end_phase();
+                std::cout <<  "relabeling took " <<  t.elapsed()  << std::endl;
 
-        local_search_mapping lsm;
+                t.restart();
+                if( time_left( config, time_limit, "local search" ) ) {
+                        run_report::begin_phase("local_search");
+                        m_local_search->set_original_ids( &new_to_old );
+                        success = local_search( config, C_new, D, perm_rank_new );
+                        m_local_search->set_original_ids( NULL );
+                        run_report::end_phase();
+                }
+                gr.map_back( perm_rank_new, new_to_old, perm_rank );
+        } else if( time_left( config, time_limit, "local search" ) ) {
+                run_report::begin_phase("local_search");
+                success = local_search( config, C, D, perm_rank );
+                run_report::end_phase();
+        }
+
+        std::cout <<  "local search took " <<  t.elapsed()  << std::endl;
+        if( !success ) return false; // C is not symmetric, the later phases rely on that as well
+
+        if( qap_lower_bound::gap_reached( config, qm.total_qap(C, D, perm_rank) ) ) {
+                std::cout <<  "gap to lower bound reached, skipping further improvement"  << std::endl;
+                return true;
+        }
+
+        if( config.enable_exact_group_search && time_left( config, time_limit, "exact group search" ) ) {
+                t.restart();
+                exact_group_mapping egm;
+                run_report::begin_phase("exact_group_search");
+                egm.perform_refinement( config, C, D, perm_rank);
+                run_report::end_phase();
+                std::cout <<  "exact group search took " <<  t.elapsed()  << std::endl;
+        }
+
+        if( config.enable_evolutionary_mapping && time_left( config, time_limit, "evolutionary mapping" ) ) {
+                t.restart();
+                evolutionary_mapping em;
+                run_report::begin_phase("evolutionary_mapping");
+                em.perform_evolution( config, C, D, perm_rank);
+                run_report::end_phase();
+                std::cout <<  "evolutionary mapping took " <<  t.elapsed()  << std::endl;
+        }
+
+        if( config.enable_tabu_search && time_left( config, time_limit, "tabu search" ) ) {
+                t.restart();
+                tabu_search_mapping tsm;
+                run_report::begin_phase("tabu_search");
+                tsm.perform_refinement( config, C, D, perm_rank);
+                run_report::end_phase();
+                std::cout <<  "tabu search took " <<  t.elapsed()  << std::endl;
+        }
+
+        // the phases after the local search may have improved the mapping
+        if( config.checkpoint_filename != "" ) {
+                m_local_search->write_checkpoint( config, perm_rank );
+        }
+        return true;
+}
+
+bool mapping_algorithms::local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
         switch( config.ls_neighborhood ) {
                 case NSQUARE:
-                        lsm.perform_local_search< full_search_space > ( config, C, D, perm_rank);
-                        break;
+                        return m_local_search->perform_local_search< full_search_space > ( config, C, D, perm_rank);
                 case NSQUAREPRUNED:
-                        lsm.perform_local_search< full_search_space_pruned > ( config, C, D, perm_rank);
-                        break;
+                        return m_local_search->perform_local_search< full_search_space_pruned > ( config, C, D, perm_rank);
                 case COMMUNICATIONGRAPH:
-                        lsm.perform_local_search< communication_graph_search_space > ( config, C, D, perm_rank);
-                        break;
+                        if( m_search_space == NULL ) {
+                                m_search_space = new communication_graph_search_space( config, C.number_of_nodes());
+                        } else {
+                                m_search_space->reset( config, C.number_of_nodes());
+                        }
+                        m_search_space->set_graph_ref( &C );
+                        return m_local_search->perform_local_search< communication_graph_search_space > ( config, C, D, perm_rank, *m_search_space);
         }
+        return true;
+}
+
+bool mapping_algorithms::remap_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, 
+                                          std::vector< NodeID > & changed_nodes) {
+        construct_distance_matrix cdm;
+        run_report::begin_phase("distance_matrix");
+        bool success = cdm.construct_matrix( config, D );
+        run_report::end_phase();
+        if( !success ) return false;
+
+        qm.set_num_threads(config.num_threads);
+        std::cout <<  "remapping, " <<  changed_nodes.size() <<  " tasks changed"  << std::endl;
+        std::cout <<  "J(C,D,Pi) = " <<  qm.total_qap(C, D, perm_rank) << std::endl;
+        compute_lower_bound( config, C );
+        t.restart();
+
+        incremental_search_space iss(config, C.number_of_nodes());
+        iss.set_graph_ref( &C );
+        iss.set_changed_nodes( changed_nodes );
+
+        run_report::begin_phase("local_search");
+        local_search_mapping lsm;
+        success = lsm.perform_local_search< incremental_search_space > ( config, C, D, perm_rank, iss);
+        run_report::end_phase();
 
         std::cout <<  "local search took " <<  t.elapsed()  << std::endl;
+        return success;
+}
+
+void mapping_algorithms::compute_changed_nodes( graph_access & old_C, graph_access & C, std::vector< NodeID > & changed_nodes) {
+        changed_nodes.clear();
+
+        std::vector< std::pair< NodeID, EdgeWeight > > old_edges, new_edges;
+        forall_nodes(C, node) {
+                old_edges.clear();
+                new_edges.clear();
+                forall_out_edges(old_C, e, node) {
+                        old_edges.push_back( std::pair< NodeID, EdgeWeight >(old_C.getEdgeTarget(e), old_C.getEdgeWeight(e)) );
+                } endfor
+                forall_out_edges(C, e, node) {
+                        new_edges.push_back( std::pair< NodeID, EdgeWeight >(C.getEdgeTarget(e), C.getEdgeWeight(e)) );
+                } endfor
+
+                if( old_edges.size() == new_edges.size() ) {
+                        std::sort(old_edges.begin(), old_edges.end());
+                        std::sort(new_edges.begin(), new_edges.end());
+                        if( old_edges == new_edges ) continue;
+                }
+                changed_nodes.push_back(node);
+        } endfor
+}
+
+void mapping_algorithms::compute_lower_bound( PartitionConfig & config, graph_access & C) {
+        qap_lower_bound qlb;
+        config.qap_lower_bound = qlb.hierarchy_gilmore_lawler( config, C );
 }
 
 void mapping_algorithms::graph_to_matrix( graph_access & C, matrix & C_bar) {
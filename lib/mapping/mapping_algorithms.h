@@ -25,19 +25,64 @@
 #include "data_structure/graph_access.h"
 #include "data_structure/matrix/normal_matrix.h"
 #include "partition_config.h"
+#include "tools/quality_metrics.h"
 #include "tools/timer.h"
 
+class communication_graph_search_space;
+class local_search_mapping;
+
 class mapping_algorithms {
 public:
         mapping_algorithms();
         virtual ~mapping_algorithms();
 
-        void construct_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+        // the mapping functions return false if the mapping could not be computed, i.e. D is not
+        // square or the objective of the local search does not match J (C is not symmetric)
+        bool construct_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+        // same as construct_a_mapping but D has to be constructed already,
+        // i.e. D can be shared by several mappings. the scratch memory of the
+        // local search is kept by this object and reused by the next call
+        bool compute_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+        // continues the improvement of a given mapping (e.g. a checkpoint), no construction
+        bool resume_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+        // input perm_rank is the mapping of a previous communication graph,
+        // only the neighborhoods of changed_nodes are searched for improvements
+        bool remap_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, 
+                              std::vector< NodeID > & changed_nodes);
+
+        // nodes whose edges (targets or weights) differ between both graphs
+        void compute_changed_nodes( graph_access & old_C, graph_access & C, std::vector< NodeID > & changed_nodes);
         void graph_to_matrix( graph_access & C, matrix & C_bar);
 
 private:
+        // owns m_local_search and m_search_space, hence not copyable
+        mapping_algorithms(const mapping_algorithms&);
+        mapping_algorithms& operator=(const mapping_algorithms&);
+
+        // local search and the optional improvement phases
+        bool improve_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+        bool improve_mapping_internal( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, 
+                                       double time_limit);
+
+        // sets config.time_limit to the time that is left of time_limit since the run began,
+        // returns false (and the phase is skipped) if nothing is left
+        bool time_left( PartitionConfig & config, double time_limit, const std::string & phase);
+
+        // local search in the neighborhood config.ls_neighborhood
+        bool local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+        // stores the qap lower bound in config, used by the gap based stopping rules
+        void compute_lower_bound( PartitionConfig & config, graph_access & C);
+
         quality_metrics qm; 
         timer_x t;
+        timer_x m_run_t; // started when a run begins, all phases share config.time_limit
+
+        local_search_mapping* m_local_search;
+        communication_graph_search_space* m_search_space;
 };
 
 
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * mapping_population.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "mapping_population.h"
+#include "tools/random_functions.h"
+
+mapping_population::mapping_population( const PartitionConfig & config ) {
+        m_population_size = std::max(2u, config.mh_pool_size);
+        m_group_size      = config.group_sizes.size() > 0 ? config.group_sizes[0] : 1;
+}
+
+mapping_population::~mapping_population() {
+
+}
+
+void mapping_population::insert( mapping_individuum & ind ) {
+        if( m_internal_population.size() < m_population_size ) {
+                m_internal_population.push_back(ind);
+                return;
+        }
+
+        long long worst_objective = 0;
+        for( unsigned i = 0; i < m_internal_population.size(); i++) {
+                worst_objective = std::max(worst_objective, m_internal_population[i].objective);
+        }
+        if( ind.objective > worst_objective ) {
+                return; // do nothing
+        }
+
+        // else replace the most similar individuum that is not better
+        unsigned max_similarity     = 0;
+        unsigned max_similarity_idx = std::numeric_limits< unsigned >::max();
+        for( unsigned i = 0; i < m_internal_population.size(); i++) {
+                if( m_internal_population[i].objective >= ind.objective ) {
+                        unsigned cur_similarity = similarity( m_internal_population[i], ind );
+                        if( max_similarity_idx == std::numeric_limits< unsigned >::max() || cur_similarity > max_similarity ) {
+                                max_similarity     = cur_similarity;
+                                max_similarity_idx = i;
+                        }
+                }
+        }
+
+        if( max_similarity == ind.perm_rank.size() && m_internal_population[max_similarity_idx].objective == ind.objective ) {
+                return; // individuum is already contained
+        }
+
+        m_internal_population[max_similarity_idx] = ind;
+}
+
+unsigned mapping_population::get_one_individual_tournament() {
+        unsigned one = random_functions::nextInt(0, m_internal_population.size()-1);
+        unsigned two = random_functions::nextInt(0, m_internal_population.size()-1);
+        return m_internal_population[one].objective < m_internal_population[two].objective ? one : two;
+}
+
+void mapping_population::get_two_individuals_tournament( unsigned & first, unsigned & second ) {
+        first  = get_one_individual_tournament();
+        second = get_one_individual_tournament();
+
+        for( unsigned tries = 0; first == second && tries < 10; tries++) {
+                second = get_one_individual_tournament();
+        }
+}
+
+unsigned mapping_population::get_best_individuum() {
+        unsigned idx = 0;
+        for( unsigned i = 1; i < m_internal_population.size(); i++) {
+                if( m_internal_population[i].objective < m_internal_population[idx].objective ) {
+                        idx = i;
+                }
+        }
+
+        return idx;
+}
+
+bool mapping_population::is_full() {
+        return m_internal_population.size() == m_population_size;
+}
+
+unsigned mapping_population::similarity( mapping_individuum & first, mapping_individuum & second ) {
+        unsigned count = 0;
+        for( unsigned i = 0; i < first.perm_rank.size(); i++) {
+                if( first.perm_rank[i] / m_group_size == second.perm_rank[i] / m_group_size ) count++;
+        }
+        return count;
+}
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * mapping_population.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef MAPPING_POPULATION_Q3V8NX1K
+#define MAPPING_POPULATION_Q3V8NX1K
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+struct mapping_individuum {
+        std::vector< NodeID > perm_rank; // task 'node' is assigned to PE perm_rank[node]
+        long long objective;             // J(C,D,perm_rank)
+};
+
+// population of one island, mirrors the population of parallel_mh
+// but works on permutations instead of partitions
+class mapping_population {
+        public:
+                mapping_population( const PartitionConfig & config );
+                virtual ~mapping_population();
+
+                // replaces the most similar individuum among those that are not better than ind
+                void insert( mapping_individuum & ind );
+
+                void get_two_individuals_tournament( unsigned & first, unsigned & second );
+
+                unsigned get_best_individuum();
+
+                mapping_individuum & get( unsigned idx ) { return m_internal_population[idx]; }
+
+                bool is_full();
+
+                unsigned size() { return m_internal_population.size(); }
+
+        private:
+                unsigned get_one_individual_tournament();
+
+                // number of tasks that are assigned to the same group of the lowest hierarchy level
+                unsigned similarity( mapping_individuum & first, mapping_individuum & second );
+
+                unsigned m_population_size;
+                unsigned m_group_size;
+                std::vector< mapping_individuum > m_internal_population;
+};
+
+
+#endif /* end of include guard: MAPPING_POPULATION_Q3V8NX1K */
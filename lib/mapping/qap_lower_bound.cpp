@@ -0,0 +1,74 @@
+/******************************************************************************
+ * qap_lower_bound.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <functional>
+
+#include "qap_lower_bound.h"
+
+qap_lower_bound::qap_lower_bound() {
+
+}
+
+qap_lower_bound::~qap_lower_bound() {
+
+}
+
+long qap_lower_bound::hierarchy_gilmore_lawler( PartitionConfig & config, graph_access & C) {
+        if( config.distance_construction_algorithm != DIST_CONST_HIERARCHY 
+         && config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE ) {
+                return 0;
+        }
+
+        // distances seen from one PE: (distance, number of PEs at this distance) 
+        std::vector< std::pair< EdgeWeight, NodeID > > row;
+        NodeID group_size = 1;
+        for( unsigned level = 0; level < config.group_sizes.size(); level++) {
+                NodeID next_group_size = group_size*config.group_sizes[level];
+                row.push_back( std::pair< EdgeWeight, NodeID >( config.distances[level], next_group_size - group_size ) );
+                group_size = next_group_size;
+        }
+        std::sort( row.begin(), row.end() );
+
+        long bound = 0;
+        std::vector< EdgeWeight > weights;
+        forall_nodes(C, node) {
+                weights.clear();
+                forall_out_edges(C, e, node) {
+                        weights.push_back(C.getEdgeWeight(e));
+                } endfor
+                std::sort( weights.begin(), weights.end(), std::greater< EdgeWeight >() );
+
+                unsigned level = 0;
+                NodeID used    = 0;
+                for( unsigned i = 0; i < weights.size() && level < row.size(); i++) {
+                        while( level < row.size() && used == row[level].second ) {
+                                level++;
+                                used = 0;
+                        }
+                        if( level == row.size() ) break;
+                        bound += (long) weights[i]*row[level].first;
+                        used++;
+                }
+        } endfor
+
+        return bound;
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * qap_lower_bound.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef QAP_LOWER_BOUND_7RN2XKPE
+#define QAP_LOWER_BOUND_7RN2XKPE
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+class qap_lower_bound {
+        public:
+                qap_lower_bound();
+                virtual ~qap_lower_bound();
+
+                // gilmore-lawler bound for a hierarchical distance matrix. all PEs see the same multiset
+                // of distances (group_sizes[0]-1 times distances[0], ...), hence the bound of a task is
+                // the sum of its edge weights in decreasing order times these distances in increasing order.
+                // returns 0 if D is not hierarchical
+                long hierarchy_gilmore_lawler( PartitionConfig & config, graph_access & C);
+
+                // relative gap in percent
+                static double gap( long long objective, long long lower_bound ) {
+                        if( lower_bound <= 0 ) return objective > 0 ? 100 : 0;
+                        return 100*(objective - lower_bound)/(double)lower_bound;
+                }
+
+                // true if the objective is within config.gap_threshold percent of config.qap_lower_bound
+                static bool gap_reached( const PartitionConfig & config, long long objective ) {
+                        if( config.gap_threshold <= 0 || config.qap_lower_bound <= 0 ) return false;
+                        return gap( objective, config.qap_lower_bound ) <= config.gap_threshold;
+                }
+};
+
+#endif /* end of include guard: QAP_LOWER_BOUND_7RN2XKPE */
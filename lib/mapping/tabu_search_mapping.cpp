@@ -0,0 +1,315 @@
+/******************************************************************************
+ * tabu_search_mapping.cpp
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "data_structure/matrix/normal_matrix.h"
+#include "partition/uncoarsening/refinement/tabu_search/tabu_bucket_queue.h"
+#include "partition/uncoarsening/refinement/tabu_search/tabu_moves_queue.h"
+#include "tools/random_functions.h"
+#include "tools/timer.h"
+#include "qap_lower_bound.h"
+#include "tabu_search_mapping.h"
+
+tabu_search_mapping::tabu_search_mapping() {
+
+}
+
+tabu_search_mapping::~tabu_search_mapping() {
+
+}
+
+void tabu_search_mapping::perform_refinement( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        timer_x t; t.restart();
+        if( C.number_of_edges() == 0 ) return;
+
+        compute_moves( C );
+
+        // gains are bucketed, the resolution is chosen such that the number of buckets stays small
+        long long max_dist = *std::max_element(config.distances.begin(), config.distances.end());
+        long long min_dist = *std::min_element(config.distances.begin(), config.distances.end());
+        long long max_weighted_degree = 0;
+        forall_nodes(C, node) {
+                long long weighted_degree = 0;
+                forall_out_edges(C, e, node) {
+                        weighted_degree += C.getEdgeWeight(e);
+                } endfor
+                max_weighted_degree = std::max(max_weighted_degree, weighted_degree);
+        } endfor
+        long long gain_bound = std::max(1LL, 2*max_weighted_degree*(max_dist - min_dist));
+        m_gain_span       = (EdgeWeight) std::min(gain_bound, 1LL << 16);
+        m_gain_resolution = (gain_bound + m_gain_span - 1) / m_gain_span;
+
+        PartitionConfig queue_config = config;
+        queue_config.k = MOVE_COLUMNS;
+        unsigned number_of_moves = m_move_source.size();
+        NodeID move_rows         = number_of_moves / MOVE_COLUMNS + 1;
+
+        tabu_bucket_queue* queue     = new tabu_bucket_queue(queue_config, m_gain_span, move_rows);
+        tabu_moves_queue* tabu_moves = new tabu_moves_queue();
+        matrix* T                    = new normal_matrix(move_rows, MOVE_COLUMNS, 0); // a move is tabu while T > iteration
+
+        for( unsigned move = 0; move < number_of_moves; move++) {
+                insert_move( config, C, D, perm_rank, queue, move );
+        }
+
+        long long cur_objective   = qm.total_qap(C, D, perm_rank);
+        long long best_objective  = cur_objective;
+        long long input_objective = cur_objective;
+
+        std::vector< std::pair< NodeID, NodeID > > undo_buffer; // swaps performed after the best solution was found
+        std::vector< unsigned > tabu_list;                     // moves that may be tabu, needed for the aspiration criterion
+        std::vector< NodeID > touched_nodes;
+        std::vector< bool > touched(C.number_of_nodes(), false);
+        std::vector< unsigned > updated(number_of_moves, 0);
+
+        unsigned tenure          = std::max(1u, std::min(config.maxT, number_of_moves/8));
+        unsigned iteration_limit = std::max(1000u, 2*C.number_of_nodes());
+        unsigned no_impro_iterations = 0;
+        unsigned iteration = 1;
+
+        for( iteration = 1; ; iteration++) {
+                if( config.time_limit > 0 ) {
+                        if( t.elapsed() > config.time_limit ) break;
+                } else if( iteration > config.maxIter ) {
+                        break;
+                }
+                if( qap_lower_bound::gap_reached( config, best_objective ) ) break;
+
+                // aspiration: a tabu move is admissible if it yields a new best solution
+                unsigned asp_move = UNDEFINED_MOVE;
+                long long asp_gain = 0;
+                for( unsigned i = 0; i < tabu_list.size(); ) {
+                        unsigned move = tabu_list[i];
+                        if( T->get_xy(move / MOVE_COLUMNS, move % MOVE_COLUMNS) <= (int)iteration ) {
+                                std::swap(tabu_list[i], tabu_list.back());
+                                tabu_list.pop_back();
+                                continue;
+                        }
+                        i++;
+
+                        NodeID lhs = m_move_source[move];
+                        NodeID rhs = m_move_target[move];
+                        if( D.get_xy(perm_rank[lhs], perm_rank[rhs]) == config.distances[0] ) continue;
+
+                        long long gain = compute_gain(C, D, perm_rank, lhs, rhs);
+                        if( cur_objective - 2*gain < best_objective && ( asp_move == UNDEFINED_MOVE || gain > asp_gain )) {
+                                asp_move = move;
+                                asp_gain = gain;
+                        }
+                }
+
+                unsigned move = UNDEFINED_MOVE;
+                long long gain = 0;
+                if( !queue->empty() ) {
+                        std::pair< NodeID, PartitionID > p = queue->deleteMax();
+                        move = p.first*MOVE_COLUMNS + p.second;
+                        gain = compute_gain(C, D, perm_rank, m_move_source[move], m_move_target[move]);
+                }
+
+                if( asp_move != UNDEFINED_MOVE && ( move == UNDEFINED_MOVE || asp_gain > gain )) {
+                        if( move != UNDEFINED_MOVE ) {
+                                queue->insert(move / MOVE_COLUMNS, move % MOVE_COLUMNS, scale(gain));
+                        }
+                        move = asp_move;
+                        gain = asp_gain;
+                } else if( move == UNDEFINED_MOVE ) {
+                        break; // there are no admissible moves left
+                }
+
+                NodeID lhs = m_move_source[move];
+                NodeID rhs = m_move_target[move];
+
+                std::swap(perm_rank[lhs], perm_rank[rhs]);
+                cur_objective -= 2*gain;
+                undo_buffer.push_back( std::pair< NodeID, NodeID >(lhs, rhs) );
+
+                // forbid swapping these two tasks back for a while
+                int tabu_until = iteration + tenure + random_functions::nextInt(0, tenure/2);
+                if( T->get_xy(move / MOVE_COLUMNS, move % MOVE_COLUMNS) <= (int)iteration ) {
+                        tabu_list.push_back(move);
+                }
+                T->set_xy(move / MOVE_COLUMNS, move % MOVE_COLUMNS, tabu_until);
+                tabu_moves->insert(move / MOVE_COLUMNS, move % MOVE_COLUMNS, tabu_until);
+
+                // the gain of a move changes if one of its endpoints or one of their neighbors changed its PE
+                touched_nodes.clear();
+                touched_nodes.push_back(lhs); touched[lhs] = true;
+                touched_nodes.push_back(rhs); touched[rhs] = true;
+                for( unsigned i = 0; i < 2; i++) {
+                        forall_out_edges(C, e, touched_nodes[i]) {
+                                NodeID target = C.getEdgeTarget(e);
+                                if( !touched[target] ) {
+                                        touched[target] = true;
+                                        touched_nodes.push_back(target);
+                                }
+                        } endfor
+                }
+
+                for( NodeID node : touched_nodes ) {
+                        touched[node] = false;
+                        for( unsigned i = m_node_moves_start[node]; i < m_node_moves_start[node+1]; i++) {
+                                unsigned cur_move = m_node_moves[i];
+                                if( updated[cur_move] == iteration ) continue;
+                                updated[cur_move] = iteration;
+
+                                NodeID row      = cur_move / MOVE_COLUMNS;
+                                PartitionID col = cur_move % MOVE_COLUMNS;
+                                if( T->get_xy(row, col) > (int)iteration ) continue; // tabu moves are not in the queue
+
+                                if( queue->contains(row, col) ) queue->deleteNode(row, col);
+                                insert_move( config, C, D, perm_rank, queue, cur_move );
+                        }
+                }
+
+                if( cur_objective < best_objective ) {
+                        best_objective      = cur_objective;
+                        no_impro_iterations = 0;
+                        undo_buffer.clear();
+                } else {
+                        no_impro_iterations++;
+                }
+
+                // moves whose tenure expired become admissible again
+                while( !tabu_moves->empty() && tabu_moves->minValue() <= (int)iteration ) {
+                        std::pair< NodeID, PartitionID > p = tabu_moves->deleteMin();
+                        if( T->get_xy(p.first, p.second) > (int)iteration ) continue; // became tabu again in the meantime
+                        if( queue->contains(p.first, p.second) ) continue;
+
+                        insert_move( config, C, D, perm_rank, queue, p.first*MOVE_COLUMNS + p.second );
+                }
+
+                // search stagnates, restart from the best solution found so far
+                if( no_impro_iterations > iteration_limit ) {
+                        for( int idx = undo_buffer.size() - 1; idx >= 0; idx--) {
+                                std::swap(perm_rank[undo_buffer[idx].first], perm_rank[undo_buffer[idx].second]);
+                        }
+                        undo_buffer.clear();
+                        cur_objective       = best_objective;
+                        no_impro_iterations = 0;
+
+                        delete queue;
+                        queue = new tabu_bucket_queue(queue_config, m_gain_span, move_rows);
+                        for( unsigned cur_move = 0; cur_move < number_of_moves; cur_move++) {
+                                if( T->get_xy(cur_move / MOVE_COLUMNS, cur_move % MOVE_COLUMNS) > (int)iteration ) continue;
+                                insert_move( config, C, D, perm_rank, queue, cur_move );
+                        }
+                }
+        }
+
+        // roll back to the best solution
+        for( int idx = undo_buffer.size() - 1; idx >= 0; idx--) {
+                std::swap(perm_rank[undo_buffer[idx].first], perm_rank[undo_buffer[idx].second]);
+        }
+
+        std::cout <<  "tabu search iterations " <<  iteration - 1
+                  <<  ", J(C,D,Pi) = " <<  best_objective <<  " (was " <<  input_objective << ")" << std::endl;
+
+        delete T;
+        delete queue;
+        delete tabu_moves;
+}
+
+void tabu_search_mapping::insert_move( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, 
+                                       tabu_bucket_queue * queue, unsigned move) {
+        NodeID lhs = m_move_source[move];
+        NodeID rhs = m_move_target[move];
+
+        // swapping two tasks of the same group does not change the objective
+        if( D.get_xy(perm_rank[lhs], perm_rank[rhs]) == config.distances[0] ) return;
+
+        queue->insert(move / MOVE_COLUMNS, move % MOVE_COLUMNS, scale(compute_gain(C, D, perm_rank, lhs, rhs)));
+}
+
+long long tabu_search_mapping::compute_gain( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID lhs, NodeID rhs) {
+        NodeID perm_rank_lhs = perm_rank[lhs];
+        NodeID perm_rank_rhs = perm_rank[rhs];
+
+        // the edge between lhs and rhs keeps its length
+        long long gain = 0;
+        forall_out_edges(C, e, lhs) {
+                NodeID target = C.getEdgeTarget(e);
+                if( target == rhs ) continue;
+                NodeID perm_rank_target = perm_rank[target];
+                gain += (long long)C.getEdgeWeight(e)*(D.get_xy(perm_rank_lhs, perm_rank_target) - D.get_xy(perm_rank_rhs, perm_rank_target));
+        } endfor
+        forall_out_edges(C, e, rhs) {
+                NodeID target = C.getEdgeTarget(e);
+                if( target == lhs ) continue;
+                NodeID perm_rank_target = perm_rank[target];
+                gain += (long long)C.getEdgeWeight(e)*(D.get_xy(perm_rank_rhs, perm_rank_target) - D.get_xy(perm_rank_lhs, perm_rank_target));
+        } endfor
+
+        return gain;
+}
+
+void tabu_search_mapping::compute_moves( graph_access & C ) {
+        // all pairs of tasks that are at most two hops apart in the communication graph
+        m_move_source.clear();
+        m_move_target.clear();
+
+        std::vector< NodeID > touched_nodes;
+        std::vector< bool > touched(C.number_of_nodes(), false);
+        forall_nodes(C, node) {
+                touched_nodes.clear();
+                touched[node] = true;
+                touched_nodes.push_back(node);
+                forall_out_edges(C, e, node) {
+                        NodeID target = C.getEdgeTarget(e);
+                        if( !touched[target] ) {
+                                touched[target] = true;
+                                touched_nodes.push_back(target);
+                        }
+                        forall_out_edges(C, e_bar, target) {
+                                NodeID target_bar = C.getEdgeTarget(e_bar);
+                                if( !touched[target_bar] ) {
+                                        touched[target_bar] = true;
+                                        touched_nodes.push_back(target_bar);
+                                }
+                        } endfor
+                } endfor
+
+                for( NodeID target : touched_nodes ) {
+                        touched[target] = false;
+                        if( node < target ) {
+                                m_move_source.push_back(node);
+                                m_move_target.push_back(target);
+                        }
+                }
+        } endfor
+
+        // incidence lists of the moves
+        m_node_moves_start.assign(C.number_of_nodes()+1, 0);
+        for( unsigned move = 0; move < m_move_source.size(); move++) {
+                m_node_moves_start[m_move_source[move]+1]++;
+                m_node_moves_start[m_move_target[move]+1]++;
+        }
+        for( unsigned i = 1; i < m_node_moves_start.size(); i++) {
+                m_node_moves_start[i] += m_node_moves_start[i-1];
+        }
+
+        std::vector< unsigned > pos(m_node_moves_start.begin(), m_node_moves_start.end()-1);
+        m_node_moves.resize(2*m_move_source.size());
+        for( unsigned move = 0; move < m_move_source.size(); move++) {
+                m_node_moves[pos[m_move_source[move]]++] = move;
+                m_node_moves[pos[m_move_target[move]]++] = move;
+        }
+}
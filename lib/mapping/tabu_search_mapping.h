@@ -0,0 +1,77 @@
+/******************************************************************************
+ * tabu_search_mapping.h
+ *
+ * Source of VieM -- Vienna Mapping and Sparse Quadratic Assignment
+ ******************************************************************************
+ * Copyright (C) 2017 Christian Schulz
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifndef TABU_SEARCH_MAPPING_7HQ2KXWD
+#define TABU_SEARCH_MAPPING_7HQ2KXWD
+
+#include <limits>
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/matrix.h"
+#include "partition_config.h"
+#include "tools/quality_metrics.h"
+
+// moves are swaps of two tasks that are at most two hops apart in the communication graph.
+// the queues of the partitioning tabu search are indexed by (node, block), hence
+// move i is stored at (i / MOVE_COLUMNS, i % MOVE_COLUMNS)
+#define MOVE_COLUMNS 64
+#define UNDEFINED_MOVE std::numeric_limits< unsigned >::max()
+
+class tabu_bucket_queue;
+
+class tabu_search_mapping {
+public:
+        tabu_search_mapping();
+        virtual ~tabu_search_mapping();
+
+        // input a valid mapping
+        // output the best mapping found within maxIter iterations or time_limit seconds
+        void perform_refinement( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+private:
+        // decrease of the objective (each edge counted once) if lhs and rhs exchange their PEs
+        long long compute_gain( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID lhs, NodeID rhs);
+
+        void compute_moves( graph_access & C );
+
+        void insert_move( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, 
+                          tabu_bucket_queue * queue, unsigned move);
+
+        // bucket of a gain, the bound uses the largest weighted degree hence clamping is only a safeguard
+        inline Gain scale( long long gain ) {
+                long long scaled = gain / m_gain_resolution;
+                if( scaled >  m_gain_span ) return  m_gain_span;
+                if( scaled < -m_gain_span ) return -m_gain_span;
+                return (Gain) scaled;
+        }
+
+        // Data Members
+        std::vector< NodeID > m_move_source;
+        std::vector< NodeID > m_move_target;
+        std::vector< unsigned > m_node_moves_start;
+        std::vector< unsigned > m_node_moves;
+        EdgeWeight m_gain_span;
+        long long m_gain_resolution;
+        quality_metrics qm;
+};
+
+
+#endif /* end of include guard: TABU_SEARCH_MAPPING_7HQ2KXWD */
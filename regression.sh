@@ -0,0 +1,85 @@
+#!/bin/bash
+
+# compares two builds of VieM, e.g. the deploy directories of two checkouts:
+#   ./regression.sh BASELINE_DIR CANDIDATE_DIR [REPETITIONS]
+# both directories have to contain generate_model and viem, the candidate directory also regression_stats.
+# objectives are deterministic for a seed, hence they are measured once per seed and compared over
+# the seeds. the time measurements are repeated and the runs of both builds are interleaved so that 
+# drift of the machine affects both builds equally. regression_stats prints medians with confidence 
+# intervals and flags significant regressions. the script exits with 1 if a regression was found.
+# for stable timings run on an idle machine and consider pinning, e.g. taskset -c 0 ./regression.sh ...
+
+if [ "$#" -lt 2 ]; then
+        echo "Usage: ./regression.sh BASELINE_DIR CANDIDATE_DIR [REPETITIONS]"
+        exit 0
+fi
+
+BASELINE=`cd "$1" && pwd`
+CANDIDATE=`cd "$2" && pwd`
+REPETITIONS=${3:-5}
+GRAPH=`cd \`dirname $0\` && pwd`/example/3elt.graph
+
+for build in "$BASELINE" "$CANDIDATE"; do
+        for program in generate_model viem; do
+                if [ ! -x "$build/$program" ]; then
+                        echo "$build/$program not found. exiting."
+                        exit 0
+                fi
+        done
+done
+
+WORK=`mktemp -d`
+RESULTS=$WORK/results.csv
+echo "% build,key,metric,sample,value" > $RESULTS
+
+# fixed matrix: number of blocks, hierarchy and distances of the system
+MATRIX="64;4:4:4;1:10:100 128;16:4:2;1:10:100 256;4:8:8;1:10:100"
+# objectives are compared over SEEDS, times are measured for the first TIME_SEEDS seeds
+SEEDS="0 1 2 3 4 5 6 7 8 9"
+TIME_SEEDS=3
+
+# total communication volume of a model (edge weights are stored in both directions)
+volume() {
+        awk 'NR > 1 { for( i = 3; i <= NF; i += 2 ) sum += $i } END { print sum/2 }' $1
+}
+
+for entry in $MATRIX; do
+        IFS=';' read K HIERARCHY DISTANCES <<< "$entry"
+        echo "k=$K hierarchy=$HIERARCHY distances=$DISTANCES"
+
+        # the mapping runs of both builds use the same model
+        "$BASELINE/generate_model" $GRAPH --k $K --seed 0 --output_filename=$WORK/model_$K.graph > /dev/null
+
+        for seed in $SEEDS; do
+                # one run per seed suffices for the objective
+                RUNS=1
+                if [ $seed -lt $TIME_SEEDS ]; then RUNS=$REPETITIONS; fi
+
+                for ((rep = 0; rep < RUNS; rep++)); do
+                        for build in baseline candidate; do
+                                if [ "$build" == "baseline" ]; then DIR=$BASELINE; else DIR=$CANDIDATE; fi
+
+                                KEY=generate_model/k$K
+                                OUT=`"$DIR/generate_model" $GRAPH --k $K --seed $seed --output_filename=$WORK/model.graph`
+                                if [ $seed -lt $TIME_SEEDS ]; then
+                                        echo "$OUT" | awk -v b=$build -v k=$KEY/seed$seed -v r=$rep '/^partitioning took/ { print b "," k ",time," r "," $3 }' >> $RESULTS
+                                fi
+                                if [ $rep -eq 0 ]; then
+                                        echo "$build,$KEY,objective,$seed,`volume $WORK/model.graph`" >> $RESULTS
+                                fi
+
+                                KEY=viem/k$K/$HIERARCHY
+                                OUT=`"$DIR/viem" $WORK/model_$K.graph --hierarchy_parameter_string=$HIERARCHY --distance_parameter_string=$DISTANCES --seed $seed --output_filename=$WORK/permutation`
+                                if [ $seed -lt $TIME_SEEDS ]; then
+                                        echo "$OUT" | awk -v b=$build -v k=$KEY/seed$seed -v r=$rep '/^time spent for mapping/ { print b "," k ",time," r "," $5 }' >> $RESULTS
+                                fi
+                                if [ $rep -eq 0 ]; then
+                                        echo "$OUT" | awk -v b=$build -v k=$KEY -v s=$seed '/^quadratic assignment objective/ { print b "," k ",objective," s "," $NF }' >> $RESULTS
+                                fi
+                        done
+                done
+        done
+done
+
+echo "raw measurements in $RESULTS"
+"$CANDIDATE/regression_stats" $RESULTS